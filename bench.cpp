@@ -0,0 +1,270 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+// Microbenchmarks for every phase and engine across digit lengths, with baseline comparison
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>     // For strncmp
+#include <algorithm>    // For std::sort
+#include <string>
+#include <map>
+#include "rtp.h"
+
+// Keeps benchmark results observable so the compiler cannot drop the work
+static volatile uint64_t g_sink;
+
+// Median and 95th percentile (per call) of one benchmark case
+struct BenchResult
+{
+    std::string name;
+    double median_ns;
+    double p95_ns;
+};
+
+// Utility function to read a nearest-rank percentile from sorted samples
+double percentile(const std::vector<double> &sorted, double pct)
+{
+    size_t rank = (size_t)(pct / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[rank];
+}
+
+// Composite function to time fn: warm up, calibrate a batch of at least 1 ms, then time reps batches
+template <typename Fn>
+BenchResult run_bench(const std::string &name, int warmup, int reps, Fn fn)
+{
+    typedef std::chrono::high_resolution_clock clock;
+
+    for (int i = 0; i < warmup; ++i)
+    {
+        g_sink = g_sink + fn();
+    }
+
+    // Short cases are repeated inside each sample so timer resolution does not dominate
+    int batch = 1;
+    for (;;)
+    {
+        auto start = clock::now();
+        for (int i = 0; i < batch; ++i) g_sink = g_sink + fn();
+        std::chrono::duration<double> elapsed = clock::now() - start;
+        if (elapsed.count() >= 1e-3 || batch >= (1 << 20)) break;
+        batch *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int r = 0; r < reps; ++r)
+    {
+        auto start = clock::now();
+        for (int i = 0; i < batch; ++i) g_sink = g_sink + fn();
+        std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        samples.push_back(elapsed.count() / batch);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    return BenchResult{name, percentile(samples, 50), percentile(samples, 95)};
+}
+
+// Helper function to load "name median_ns" lines written by --save-baseline, returns false when
+// the file cannot be read or holds no entries
+bool load_baseline(const char *path, std::map<std::string, double> &baseline)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Error: cannot open baseline file '%s'.\n", path);
+        return false;
+    }
+
+    char name[128];
+    double median_ns;
+    while (fscanf(file, "%127s %lf", name, &median_ns) == 2)
+    {
+        baseline[name] = median_ns;
+    }
+    fclose(file);
+
+    if (baseline.empty())
+    {
+        fprintf(stderr, "Error: baseline file '%s' has no entries.\n", path);
+        return false;
+    }
+    return true;
+}
+
+// Driver function to run the benchmark suite
+int main(int argc, char *argv[])
+{
+    int max_digits = 10;
+    int warmup = 1;
+    int reps = 5;
+    double tolerance = 10.0; // Allowed slowdown in percent before a case counts as a regression
+    const char *baseline_path = NULL;
+    const char *save_path = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--max-digits=", 13) == 0) max_digits = atoi(argv[i] + 13);
+        else if (strncmp(argv[i], "--warmup=", 9) == 0) warmup = atoi(argv[i] + 9);
+        else if (strncmp(argv[i], "--reps=", 7) == 0) reps = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--tolerance=", 12) == 0) tolerance = atof(argv[i] + 12);
+        else if (strncmp(argv[i], "--baseline=", 11) == 0) baseline_path = argv[i] + 11;
+        else if (strncmp(argv[i], "--save-baseline=", 16) == 0) save_path = argv[i] + 16;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--max-digits=N] [--warmup=N] [--reps=N] [--tolerance=PCT] "
+                            "[--baseline=FILE] [--save-baseline=FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (max_digits < 1 || max_digits > 19 || reps < 1 || warmup < 0)
+    {
+        fprintf(stderr, "Error: need 1 <= max-digits <= 19, reps >= 1 and warmup >= 0.\n");
+        return 1;
+    }
+
+    // Load the baseline first so a bad path fails before minutes of benchmarking
+    std::map<std::string, double> baseline;
+    if (baseline_path && !load_baseline(baseline_path, baseline)) return 1;
+
+    int threads = (int)std::thread::hardware_concurrency();
+    if (threads < 1) threads = 1;
+
+    std::vector<BenchResult> results;
+    for (int digits = 1; digits <= max_digits; ++digits)
+    {
+        unsigned long long max_end = power_of_10(digits) - 1;
+        std::string suffix = "/" + std::to_string(digits);
+
+        // Inputs shared by the phases downstream of prime generation
+        PrimeBuffer all_primes(2, max_end);
+        if (!all_primes.ok())
+        {
+            fprintf(stderr, "Error generating primes.\n");
+            return 1;
+        }
+        PrimeSpan all_primes_array = all_primes.span();
+        std::vector<size_t> digit_offsets = find_digit_windows(all_primes_array, digits);
+        Wheel30Bitset prime_bitset(max_end);
+        for (size_t i = 0; i < all_primes_array.size(); ++i)
+        {
+            prime_bitset.set(all_primes_array[i]);
+        }
+
+        results.push_back(run_bench("generate" + suffix, warmup, reps, [&]() {
+            PrimeBuffer primes(2, max_end);
+            return (uint64_t)primes.size();
+        }));
+
+        results.push_back(run_bench("bitmap" + suffix, warmup, reps, [&]() {
+            Wheel30Bitset bitset(max_end);
+            for (size_t i = 0; i < all_primes_array.size(); ++i)
+            {
+                bitset.set(all_primes_array[i]);
+            }
+            return (uint64_t)bitset.test(max_end);
+        }));
+
+        results.push_back(run_bench("count" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> primes_per_digit(digits + 1, 0);
+            uint64_t total = 0;
+            for (int k = digits; k > 0; k--)
+            {
+                total += count_right_trunc_primes(all_primes_array, digit_offsets, primes_per_digit, prime_bitset, k);
+            }
+            return total;
+        }));
+
+        results.push_back(run_bench("count_parallel" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> primes_per_digit(digits + 1, 0);
+            std::vector<uint64_t> right_trunc_per_digit(digits + 1, 0);
+            return (uint64_t)count_right_trunc_primes_parallel(all_primes_array, digit_offsets, primes_per_digit,
+                                                               right_trunc_per_digit, prime_bitset, digits, threads);
+        }));
+
+        results.push_back(run_bench("memo" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> primes_per_digit(digits + 1, 0);
+            Wheel30Bitset right_trunc_bitset(power_of_10(digits - 1) - 1);
+            uint64_t total = 0;
+            for (int k = 1; k <= digits; k++)
+            {
+                total += count_right_trunc_primes_memo(all_primes_array, digit_offsets, primes_per_digit, right_trunc_bitset, k);
+            }
+            return total;
+        }));
+
+        results.push_back(run_bench("stream" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> primes_per_digit(digits + 1, 0);
+            std::vector<uint64_t> right_trunc_per_digit(digits + 1, 0);
+            Wheel30Bitset right_trunc_bitset(power_of_10(digits - 1) - 1);
+            return (uint64_t)count_right_trunc_primes_stream(primes_per_digit, right_trunc_per_digit, right_trunc_bitset, digits);
+        }));
+
+        results.push_back(run_bench("tree" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> right_trunc_per_digit(digits + 1, 0);
+            return (uint64_t)count_right_trunc_primes_tree(right_trunc_per_digit, digits);
+        }));
+
+        results.push_back(run_bench("table" + suffix, warmup, reps, [&]() {
+            RtpContext context;
+            return context.count(digits, RTP_ENGINE_TABLE).total_right_trunc();
+        }));
+
+        results.push_back(run_bench("tree_parallel" + suffix, warmup, reps, [&]() {
+            std::vector<uint64_t> right_trunc_per_digit(digits + 1, 0);
+            return (uint64_t)count_right_trunc_primes_tree_parallel(right_trunc_per_digit, digits, threads);
+        }));
+    }
+
+    // Print the report, flagging cases slower than the baseline by more than the tolerance, and
+    // cases the baseline does not cover when comparing against one
+    int regressions = 0;
+    int missing = 0;
+    printf("%-20s %16s %16s %16s %10s\n", "case", "median (ns)", "p95 (ns)", "baseline (ns)", "delta");
+    for (const BenchResult &result : results)
+    {
+        printf("%-20s %16.1f %16.1f", result.name.c_str(), result.median_ns, result.p95_ns);
+
+        auto it = baseline.find(result.name);
+        if (!baseline_path)
+        {
+            printf(" %16s %10s\n", "-", "-");
+            continue;
+        }
+        if (it == baseline.end())
+        {
+            missing++;
+            printf(" %16s %10s  MISSING FROM BASELINE\n", "-", "-");
+            continue;
+        }
+
+        double delta = (result.median_ns - it->second) / it->second * 100;
+        bool regressed = delta > tolerance;
+        if (regressed) regressions++;
+        printf(" %16.1f %+9.1f%%%s\n", it->second, delta, regressed ? "  REGRESSION" : "");
+    }
+
+    if (save_path)
+    {
+        FILE *file = fopen(save_path, "w");
+        if (!file)
+        {
+            fprintf(stderr, "Error: cannot write baseline file '%s'.\n", save_path);
+            return 1;
+        }
+        for (const BenchResult &result : results)
+        {
+            fprintf(file, "%s %.1f\n", result.name.c_str(), result.median_ns);
+        }
+        fclose(file);
+    }
+
+    if (missing > 0)
+    {
+        printf("\n%d case(s) missing from the baseline.\n", missing);
+    }
+    if (regressions > 0)
+    {
+        printf("\n%d case(s) regressed by more than %.1f%%.\n", regressions, tolerance);
+    }
+    return regressions > 0 || missing > 0 ? 1 : 0;
+}
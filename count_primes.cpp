@@ -1,73 +1,379 @@
 // Author   : Ebod Shojaei
 // Updated  : 30-11-2025
 
-// Optimized: Use array + bitset
+// Command-line driver for librtp (see rtp.h)
 #include <chrono>       // For ns timing via cpp :3
+#include <ctime>        // For CPU time via std::clock
+#include <new>          // For std::bad_alloc
+#include <algorithm>    // For std::min
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>     // For uint64_t
 #include <stddef.h>     // For size_t
+#include <string.h>     // For strcmp, strncmp
 #include <vector>
-#include <primesieve.h> // For primes
+#include <sys/resource.h> // For peak RSS via getrusage
+#include "rtp.h"
+#include "rtp_daemon.h"
 
-// Utility function to calculate power of 10
-unsigned long long power_of_10(int exp)
+// Utility function to print a 128-bit value in decimal on its own line
+static void print_u128(rtp_u128 value)
 {
-    unsigned long long res = 1;
-    for (int i = 0; i < exp; ++i)
+    char digits[40];
+    int length = 0;
+    do
     {
-        res *= 10;
+        digits[length++] = (char)('0' + (int)(value % 10));
+        value /= 10;
+    } while (value != 0);
+    while (length > 0) putchar(digits[--length]);
+    putchar('\n');
+}
+
+// Helper function to name the counted family in the report
+const char *family_label(RtpPolicy policy)
+{
+    switch (policy)
+    {
+    case RTP_POLICY_RIGHT:     return "right-truncatable";
+    case RTP_POLICY_LEFT:      return "left-truncatable";
+    case RTP_POLICY_TWO_SIDED: return "two-sided";
+    }
+    return "truncatable";
+}
+
+// Helper function to print the per-digit table (the n column is skipped when primes_per_digit is
+// null, and for levels above prime_digits, whose primes were never counted)
+void print_right_trunc_table(const std::vector<uint64_t> &right_trunc_per_digit,
+                             const std::vector<uint64_t> *primes_per_digit, int digits,
+                             const char *family = "right-truncatable", int prime_digits = 0)
+{
+    if (prime_digits < 1) prime_digits = digits;
+
+    uint64_t total_count = 0;
+    uint64_t total_primes = 0;
+    for (int i = digits; i > 0; i--)
+    {
+        total_count += right_trunc_per_digit[i];
+        if (primes_per_digit && i <= prime_digits)
+        {
+            total_primes += (*primes_per_digit)[i];
+            printf("Number of %d-digit %s primes: %llu (n = %llu)\n", i, family, (unsigned long long)right_trunc_per_digit[i], (unsigned long long)(*primes_per_digit)[i]);
+        }
+        else
+        {
+            printf("Number of %d-digit %s primes: %llu\n", i, family, (unsigned long long)right_trunc_per_digit[i]);
+        }
+    }
+
+    if (primes_per_digit && prime_digits < digits)
+    {
+        printf("\nTotal number of %s primes up to %d digits: %llu (n = %llu up to %d digits)\n\n", family, digits, (unsigned long long)total_count, (unsigned long long)total_primes, prime_digits);
+    }
+    else if (primes_per_digit)
+    {
+        printf("\nTotal number of %s primes up to %d digits: %llu (n = %llu)\n\n", family, digits, (unsigned long long)total_count, (unsigned long long)total_primes);
+    }
+    else
+    {
+        printf("\nTotal number of %s primes up to %d digits: %llu\n\n", family, digits, (unsigned long long)total_count);
+    }
+}
+
+// Running total of bytes requested through operator new, used for per-phase allocation stats
+// (new/delete are kept out of line so the compiler never pairs an inlined malloc() with delete)
+static std::atomic<uint64_t> g_bytes_allocated(0);
+
+__attribute__((noinline)) void *operator new(size_t size)
+{
+    g_bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    if (void *ptr = malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept { free(ptr); }
+__attribute__((noinline)) void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+// Utility function to read the peak resident set size in KiB
+long peak_rss_kb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Reported in bytes on macOS
+#else
+    return usage.ru_maxrss;        // Reported in KiB on Linux
+#endif
+}
+
+// Wall time, CPU time, peak RSS and bytes allocated for one phase of a run
+struct PhaseStats
+{
+    const char *name;
+    double wall_ms;
+    double cpu_ms;
+    long peak_rss_kb;
+    uint64_t bytes_allocated;
+};
+
+// Records consecutive phases (generate, bitmap, count, ...) of a run
+class PhaseLog
+{
+public:
+    void begin(const char *name)
+    {
+        current_ = PhaseStats{name, 0, 0, 0, 0};
+        wall_start_ = std::chrono::high_resolution_clock::now();
+        cpu_start_ = std::clock();
+        bytes_start_ = g_bytes_allocated.load(std::memory_order_relaxed);
+    }
+
+    void end()
+    {
+        std::chrono::duration<double> wall = std::chrono::high_resolution_clock::now() - wall_start_;
+        current_.wall_ms = wall.count() * 1000;
+        current_.cpu_ms = (double)(std::clock() - cpu_start_) * 1000 / CLOCKS_PER_SEC;
+        current_.peak_rss_kb = peak_rss_kb();
+        current_.bytes_allocated += g_bytes_allocated.load(std::memory_order_relaxed) - bytes_start_;
+        phases_.push_back(current_);
+    }
+
+    // Record a phase timed elsewhere (e.g. a stage summed over the library's per-level loop)
+    void add(const char *name, const RtpStageStats &stats)
+    {
+        phases_.push_back(PhaseStats{name, stats.wall_ms, stats.cpu_ms, stats.peak_rss_kb, stats.bytes_allocated});
     }
-    return res;
+
+    const std::vector<PhaseStats> &phases() const { return phases_; }
+
+private:
+    std::vector<PhaseStats> phases_;
+    PhaseStats current_;
+    std::chrono::high_resolution_clock::time_point wall_start_;
+    std::clock_t cpu_start_;
+    uint64_t bytes_start_;
+};
+
+// Helper function to emit the per-digit table and phase breakdown as one JSON object
+void print_json_report(const char *engine, const char *policy, int base, int digits, int depth, int prime_digits, int threads,
+                       const std::vector<uint64_t> &right_trunc_per_digit,
+                       const std::vector<uint64_t> *primes_per_digit,
+                       const PhaseLog &phase_log, double wall_ms)
+{
+    uint64_t total_count = 0;
+    uint64_t total_primes = 0;
+
+    printf("{\n  \"engine\": \"%s\",\n  \"policy\": \"%s\",\n  \"base\": %d,\n  \"digits\": %d,\n  \"depth\": %d,\n  \"threads\": %d,\n  \"per_digit\": [",
+           engine, policy, base, digits, depth, threads);
+    for (int i = 1; i <= digits; ++i)
+    {
+        total_count += right_trunc_per_digit[i];
+        printf("%s\n    {\"digits\": %d, \"right_truncatable\": %llu", i > 1 ? "," : "", i, (unsigned long long)right_trunc_per_digit[i]);
+        if (primes_per_digit && i <= prime_digits)
+        {
+            total_primes += (*primes_per_digit)[i];
+            printf(", \"primes\": %llu", (unsigned long long)(*primes_per_digit)[i]);
+        }
+        printf("}");
+    }
+    printf("\n  ],\n  \"total_right_truncatable\": %llu,\n", (unsigned long long)total_count);
+    if (primes_per_digit) printf("  \"total_primes\": %llu,\n", (unsigned long long)total_primes);
+
+    printf("  \"phases\": [");
+    const std::vector<PhaseStats> &phases = phase_log.phases();
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        printf("%s\n    {\"name\": \"%s\", \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"peak_rss_kb\": %ld, \"bytes_allocated\": %llu}",
+               i > 0 ? "," : "", phases[i].name, phases[i].wall_ms, phases[i].cpu_ms,
+               phases[i].peak_rss_kb, (unsigned long long)phases[i].bytes_allocated);
+    }
+    printf("\n  ],\n  \"wall_ms\": %.3f\n}\n", wall_ms);
 }
 
-// Composite function to calculate total number of right-truncatable primes
-int count_right_trunc_primes(const std::vector<unsigned long long> &all_primes_array,
-                             std::vector<uint64_t> &primes_per_digit,
-                             const std::vector<bool> &prime_bitset, int digits)
+// Buffered writer for batch output (one fwrite per 1 MiB instead of one printf per value)
+class OutputBuffer
 {
-    if (digits < 1 || digits > 19)
+public:
+    explicit OutputBuffer(FILE *file) : file_(file), used_(0) {}
+    ~OutputBuffer() { flush(); }
+
+    void put(char c)
     {
-        fprintf(stderr, "Error: digits must be between 1 and 19 for unsigned long long.\n");
-        return -1;
+        if (used_ == sizeof(buffer_)) flush();
+        buffer_[used_++] = c;
     }
 
-    primes_per_digit[digits] = 0;
+    void put_u64(unsigned long long value)
+    {
+        char digits[20];
+        int length = 0;
+        do
+        {
+            digits[length++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) put(digits[--length]);
+    }
 
-    // Iterate through primes of the specified "digits" length
-    int right_truncatable_count = 0;
-    unsigned long long current_digits_start = power_of_10(digits - 1);
-    unsigned long long current_digits_end   = power_of_10(digits) - 1;
+    void flush()
+    {
+        if (used_ > 0) fwrite(buffer_, 1, used_, file_);
+        used_ = 0;
+    }
+
+private:
+    FILE *file_;
+    size_t used_;
+    char buffer_[1 << 20];
+};
 
-    for (size_t i = 0; i < all_primes_array.size(); ++i)
+// Helper function to answer one batch of queries: "<n> <is_prime> <is_right_truncatable> <prefix_depth>"
+void answer_batch(const std::vector<unsigned long long> &values, OutputBuffer &out)
+{
+    for (unsigned long long n : values)
     {
-        unsigned long long current_prime = all_primes_array[i];
+        out.put_u64(n);
+        out.put(' ');
+        out.put(is_prime(n) ? '1' : '0');
+        out.put(' ');
+        out.put(rtp_is_right_truncatable(n) ? '1' : '0');
+        out.put(' ');
+        out.put_u64((unsigned long long)rtp_prime_prefix_depth(n));
+        out.put('\n');
+    }
+}
 
-        // Skip primes outside current "digits" length window
-        if (current_prime < current_digits_start) continue;
-        if (current_prime > current_digits_end) break;
+// Composite function to stream queries from a file (or stdin when path is NULL): newline or
+// whitespace separated decimals, or raw native-endian 64-bit integers with binary set
+int run_batch(const char *path, bool binary)
+{
+    FILE *in = path ? fopen(path, binary ? "rb" : "r") : stdin;
+    if (!in)
+    {
+        fprintf(stderr, "Error: cannot open '%s'.\n", path);
+        return 1;
+    }
 
-        primes_per_digit[digits]++;
+    static const size_t BATCH_SIZE = 4096;
+    static char chunk[1 << 20];
+    static OutputBuffer out(stdout); // 1 MiB, kept off the stack like chunk
+    std::vector<unsigned long long> values;
+    values.reserve(BATCH_SIZE);
 
-        int is_r_truncatable = 1; // Assume right-truncatable until proven otherwise
-        unsigned long long temp_prime = current_prime;
+    // Decimal parser state carried across chunk boundaries
+    unsigned long long value = 0;
+    bool in_number = false;
+    // Binary parser state for a value split across chunk boundaries
+    unsigned char partial[8];
+    size_t partial_size = 0;
 
-        while (temp_prime > 0) // Loop until the number becomes 0 (all digits removed)
+    // A parse error is reported after every value read before it has been answered
+    char error[64] = "";
+    int status = 0;
+    size_t size;
+    while (status == 0 && (size = fread(chunk, 1, sizeof(chunk), in)) > 0)
+    {
+        for (size_t i = 0; i < size; ++i)
         {
-            // Check if the current truncated number is prime using bitset
-            if (temp_prime >= prime_bitset.size() || !prime_bitset[temp_prime])
+            if (binary)
+            {
+                partial[partial_size++] = (unsigned char)chunk[i];
+                if (partial_size < 8) continue;
+                memcpy(&value, partial, 8);
+                partial_size = 0;
+                values.push_back(value);
+            }
+            else if (chunk[i] >= '0' && chunk[i] <= '9')
+            {
+                unsigned long long digit = (unsigned long long)(chunk[i] - '0');
+                if (value > (~0ULL - digit) / 10)
+                {
+                    snprintf(error, sizeof(error), "value does not fit in 64 bits");
+                    status = 1;
+                    break;
+                }
+                value = value * 10 + digit;
+                in_number = true;
+                continue;
+            }
+            else if (chunk[i] == ' ' || chunk[i] == '\n' || chunk[i] == '\r' || chunk[i] == '\t')
+            {
+                if (!in_number) continue;
+                values.push_back(value);
+                value = 0;
+                in_number = false;
+            }
+            else
             {
-                is_r_truncatable = 0; // Not a right-truncatable prime
+                snprintf(error, sizeof(error), "unexpected character '%c' in input", chunk[i]);
+                status = 1;
                 break;
             }
 
-            temp_prime /= 10; // Remove the rightmost digit
+            if (values.size() == BATCH_SIZE)
+            {
+                answer_batch(values, out);
+                values.clear();
+            }
         }
+    }
 
-        if (is_r_truncatable) right_truncatable_count++;
+    if (status == 0)
+    {
+        if (in_number) values.push_back(value);
+        if (partial_size != 0)
+        {
+            snprintf(error, sizeof(error), "binary input is not a multiple of 8 bytes");
+            status = 1;
+        }
     }
+    answer_batch(values, out);
+    out.flush();
+    fflush(stdout);
+    if (status != 0) fprintf(stderr, "Error: %s.\n", error);
 
-    return right_truncatable_count;
+    if (path) fclose(in);
+    return status;
+}
+
+// Composite function to sweep bases 2..max_base, streaming each base as CSV rows or one JSON line
+int run_sweep(int max_base, RtpPolicy policy, int threads, bool json)
+{
+    if (max_base < RTP_MIN_BASE || max_base > RTP_MAX_BASE)
+    {
+        fprintf(stderr, "Error: --sweep needs a largest base between %d and %d.\n", RTP_MIN_BASE, RTP_MAX_BASE);
+        return 1;
+    }
+
+    if (!json) printf("base,digits,count\n");
+    rtp_sweep_bases(policy, RTP_MIN_BASE, max_base, threads, [&](const RtpResult &result) {
+        // Rows stop at the first empty level: every longer one is empty too
+        int last = 1;
+        while (last < result.digits && result.right_trunc_per_digit[last] != 0) last++;
+
+        if (json)
+        {
+            // A tree with survivors at the last representable level was cut at the word width
+            bool truncated = result.right_trunc_per_digit[result.digits] != 0;
+            printf("{\"base\": %d, \"policy\": \"%s\", \"digits\": %d, \"per_digit\": [",
+                   result.base, rtp_policy_name(result.policy), result.digits);
+            for (int i = 1; i <= last; ++i)
+            {
+                printf("%s%llu", i > 1 ? ", " : "", (unsigned long long)result.right_trunc_per_digit[i]);
+            }
+            printf("], \"total\": %llu, \"truncated\": %s}\n", (unsigned long long)result.total_right_trunc(),
+                   truncated ? "true" : "false");
+        }
+        else
+        {
+            for (int i = 1; i <= last; ++i)
+            {
+                printf("%d,%d,%llu\n", result.base, i, (unsigned long long)result.right_trunc_per_digit[i]);
+            }
+        }
+        fflush(stdout); // Stream each base as it completes, even into a pipe
+    });
+    return 0;
 }
 
 // Driver function to run the program
@@ -76,62 +382,231 @@ int main(int argc, char *argv[])
     // Setup the timer
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    if (argc != 2)
+    if (argc < 2)
     {
-        fprintf(stderr, "Usage: %s <number_of_digits>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <number_of_digits> [sieve|memo|stream|tree|table] [--policy=right|left|two-sided] [--base=B] [--threads=N] [--prime-counts] [--json] [--list]\n", argv[0]);
+        fprintf(stderr, "       %s --batch [FILE] [--binary]\n", argv[0]);
+        fprintf(stderr, "       %s --daemon SOCKET_PATH [--threads=N]\n", argv[0]);
+        fprintf(stderr, "       %s --sweep MAX_BASE [--policy=right|left|two-sided] [--threads=N] [--json]\n", argv[0]);
         return 1;
     }
+
+    // Batch query mode: classify every value read from FILE (or stdin)
+    if (strcmp(argv[1], "--batch") == 0)
+    {
+        const char *path = NULL;
+        bool binary = false;
+        for (int i = 2; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--binary") == 0) binary = true;
+            else path = argv[i];
+        }
+        return run_batch(path, binary);
+    }
+
+    // Daemon mode: keep the structures warm and serve requests over a Unix socket
+    if (strcmp(argv[1], "--daemon") == 0)
+    {
+        if (argc < 3)
+        {
+            fprintf(stderr, "Error: --daemon needs a socket path.\n");
+            return 1;
+        }
+        int threads = (int)std::thread::hardware_concurrency();
+        if (argc > 3 && strncmp(argv[3], "--threads=", 10) == 0) threads = atoi(argv[3] + 10);
+        return run_daemon(argv[2], threads);
+    }
     
+    // Sweep mode: every base from 2 to MAX_BASE on one shared thread pool
+    if (strcmp(argv[1], "--sweep") == 0)
+    {
+        if (argc < 3)
+        {
+            fprintf(stderr, "Error: --sweep needs the largest base.\n");
+            return 1;
+        }
+        RtpPolicy policy = RTP_POLICY_RIGHT;
+        int threads = (int)std::thread::hardware_concurrency();
+        bool json = false;
+        for (int i = 3; i < argc; ++i)
+        {
+            if (strncmp(argv[i], "--threads=", 10) == 0)
+            {
+                threads = atoi(argv[i] + 10);
+                if (threads < 1) threads = (int)std::thread::hardware_concurrency();
+            }
+            else if (strcmp(argv[i], "--json") == 0) json = true;
+            else if (strncmp(argv[i], "--policy=", 9) != 0 || !rtp_parse_policy(argv[i] + 9, &policy))
+            {
+                fprintf(stderr, "Error: unknown sweep option '%s'.\n", argv[i]);
+                return 1;
+            }
+        }
+        return run_sweep(atoi(argv[2]), policy, threads, json);
+    }
+
     int digits = atoi(argv[1]);
-    if (digits < 1 || digits > 19)
+
+    RtpEngine engine = RTP_ENGINE_SIEVE;
+    RtpPolicy policy = RTP_POLICY_RIGHT;
+    int base = 10;
+    bool engine_given = false;
+    int threads = 1;
+    bool json = false;
+    bool list = false;
+    bool prime_counts = false;
+    for (int i = 2; i < argc; ++i)
     {
-        fprintf(stderr, "Error: digits must be between 1 and 19 for unsigned long long.\n");
-        return 1;
+        if (strncmp(argv[i], "--threads=", 10) == 0)
+        {
+            threads = atoi(argv[i] + 10);
+            if (threads < 1) threads = (int)std::thread::hardware_concurrency();
+        }
+        else if (strncmp(argv[i], "--policy=", 9) == 0)
+        {
+            if (!rtp_parse_policy(argv[i] + 9, &policy))
+            {
+                fprintf(stderr, "Error: unknown policy '%s' (expected right, left or two-sided).\n", argv[i] + 9);
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--base=", 7) == 0)
+        {
+            base = atoi(argv[i] + 7);
+            if (base < RTP_MIN_BASE || base > RTP_MAX_BASE)
+            {
+                fprintf(stderr, "Error: base must be between %d and %d.\n", RTP_MIN_BASE, RTP_MAX_BASE);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else if (strcmp(argv[i], "--list") == 0)
+        {
+            list = true;
+        }
+        else if (strcmp(argv[i], "--prime-counts") == 0)
+        {
+            prime_counts = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            if (!rtp_parse_engine(argv[i], &engine))
+            {
+                fprintf(stderr, "Error: unknown engine '%s' (expected sieve, memo, stream, tree or table).\n", argv[i]);
+                return 1;
+            }
+            engine_given = true;
+        }
+        else
+        {
+            fprintf(stderr, "Error: unknown option '%s'.\n", argv[i]);
+            return 1;
+        }
     }
 
-    // 1. Generate ALL primes up to the max number of digits specified
-    unsigned long long MAX_END   = power_of_10(digits) - 1;
-    unsigned long long MIN_START = 2;
+    // Only the tree engine knows the left and two-sided policies, other bases and 128-bit values,
+    // so it is their default
+    if ((policy != RTP_POLICY_RIGHT || base != 10 || digits > RTP_MAX_SIEVE_DIGITS) && !engine_given) engine = RTP_ENGINE_TREE;
+
+    char family[64];
+    if (base == 10) snprintf(family, sizeof(family), "%s", family_label(policy));
+    else snprintf(family, sizeof(family), "base-%d %s", base, family_label(policy));
 
-    size_t all_primes_count;
-    unsigned long long *all_primes_array_ptr = (unsigned long long *)primesieve_generate_primes(MIN_START, MAX_END, &all_primes_count, ULONGLONG_PRIMES);
-    if (!all_primes_array_ptr)
+    int max_digits = engine == RTP_ENGINE_TREE ? rtp_max_digits(policy, base) : RTP_MAX_SIEVE_DIGITS;
+    if (digits < 1 || digits > max_digits)
     {
-        fprintf(stderr, "Error generating primes.\n");
+        fprintf(stderr, "Error: digits must be between 1 and %d for %s primes with the %s engine.\n",
+                max_digits, family, rtp_engine_name(engine));
         return 1;
     }
 
-    std::vector<unsigned long long> all_primes_array(all_primes_array_ptr, all_primes_array_ptr + all_primes_count);
-    primesieve_free(all_primes_array_ptr);
+    RtpContext context(threads);
+    PhaseLog phase_log;
 
-    // 2. Build a bitset for prime membership checks
-    std::vector<bool> prime_bitset(MAX_END + 1, false);
-    for (size_t i = 0; i < all_primes_array.size(); ++i)
+    // Calculate the number of right-truncatable primes for every digit length. The sieve engines
+    // generate primes one digit length at a time inside the count, so a level without
+    // right-truncatable primes stops them before any longer prime is sieved; their stages are
+    // timed by the library and summed over the levels
+    RtpResult result;
+    if (engine == RTP_ENGINE_SIEVE || engine == RTP_ENGINE_MEMO)
+    {
+        result = context.count(digits, engine, policy, base);
+        phase_log.add("generate", result.generate_stats);
+        if (engine == RTP_ENGINE_SIEVE)
+        {
+            phase_log.add("bitmap", result.bitmap_stats);
+        }
+        phase_log.add("count", result.count_stats);
+    }
+    else
+    {
+        phase_log.begin(engine == RTP_ENGINE_TREE ? "expand" : engine == RTP_ENGINE_STREAM ? "stream" : "lookup");
+        result = context.count(digits, engine, policy, base);
+        phase_log.end();
+    }
+    if (result.status != RTP_OK)
     {
-        prime_bitset[all_primes_array[i]] = true;
+        fprintf(stderr, "Error counting %s primes for %d digits: %s.\n", family, digits, rtp_status_message(result.status));
+        return 1;
     }
 
-    std::vector<uint64_t> primes_per_digit(digits + 1, 0);
+    // The tree is cut at the word width: survivors at the last level may have longer descendants
+    if (engine == RTP_ENGINE_TREE && digits == max_digits && result.right_trunc_per_digit[digits] != 0)
+    {
+        fprintf(stderr, "Warning: the %s tree still grows at %d digits, longer primes do not fit the word width.\n", family, digits);
+    }
 
-    // Calculate total number of right-truncatable primes up to the specified number of digits
-    int total_count = 0;
-    for (int i = digits; i > 0; i--)
+    // Levels the engine never sieved (all of them for the tree and table engines) get their prime
+    // counts from one pi(x) run, as far as the numbers fit in 64 bits and its tables in memory
+    int prime_digits = result.has_prime_counts ? result.depth : 0;
+    int last_prime_digits = std::min(digits, rtp_max_prime_count_digits(base));
+    if (prime_counts && last_prime_digits < digits)
     {
-        int count = count_right_trunc_primes(all_primes_array, primes_per_digit, prime_bitset, i);
-        if (count < 0)
+        fprintf(stderr, "Warning: prime counts stop at %d digits, longer lengths do not fit in 64 bits or in memory.\n", last_prime_digits);
+    }
+    if (prime_counts && prime_digits < last_prime_digits)
+    {
+        phase_log.begin("prime-counts");
+        RtpStatus status = rtp_count_primes_per_digit(result.primes_per_digit, prime_digits + 1, last_prime_digits, base,
+                                                      context.threads());
+        phase_log.end();
+        if (status != RTP_OK)
         {
-            fprintf(stderr, "Error counting right-truncatable primes for %d digits.\n", i);
+            fprintf(stderr, "Error counting primes for %d digits: %s.\n", digits, rtp_status_message(status));
             return 1;
         }
-        total_count += count;
-        printf("Number of %d-digit right-truncatable primes: %d (n = %llu)\n", i, count, primes_per_digit[i]);
+        prime_digits = last_prime_digits;
     }
-    printf("\nTotal number of right-truncatable primes up to %d digits: %d (n = %zu)\n\n", digits, total_count, all_primes_count);
+
+    const std::vector<uint64_t> *primes_per_digit = prime_digits > 0 ? &result.primes_per_digit : NULL;
 
     // Print the execution time
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed_time = end_time - start_time;
     double time_diff = elapsed_time.count();
+
+    if (json)
+    {
+        print_json_report(rtp_engine_name(engine), rtp_policy_name(policy), base, digits, result.depth, prime_digits, context.threads(), result.right_trunc_per_digit,
+                          primes_per_digit, phase_log, time_diff * 1000);
+        return 0;
+    }
+
+    // List the primes themselves first (lazily enumerated in ascending order)
+    if (list)
+    {
+        for (const RtpPrime &prime : RtpRange(digits, policy, base))
+        {
+            print_u128(prime.value);
+        }
+        printf("\n");
+    }
+
+    print_right_trunc_table(result.right_trunc_per_digit, primes_per_digit, digits, family, prime_digits);
+
     // Print the execution time in ms granularity
     printf("Execution time: %.3f milliseconds\n", time_diff * 1000);
     // Print the execution time in us granularity
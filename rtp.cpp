@@ -0,0 +1,1957 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+#include "rtp.h"
+#include <string.h>     // For strcmp
+#include <algorithm>    // For std::lower_bound
+#include <utility>      // For std::index_sequence
+#include <math.h>       // For sqrtl
+#include <unistd.h>     // For sysconf
+#include <stdio.h>      // For reading /proc/self/statm
+#include <sys/resource.h> // For stage RSS via getrusage off Linux
+#include <condition_variable>
+#include <chrono>       // For stage wall time
+#include <ctime>        // For stage CPU time via std::clock
+#include <primesieve.h> // For primes
+
+// Utility function to calculate power of 10
+unsigned long long power_of_10(int exp)
+{
+    unsigned long long res = 1;
+    for (int i = 0; i < exp; ++i)
+    {
+        res *= 10;
+    }
+    return res;
+}
+
+PrimeBuffer::PrimeBuffer(unsigned long long start, unsigned long long stop) : count_(0)
+{
+    data_ = (unsigned long long *)primesieve_generate_primes(start, stop, &count_, ULONGLONG_PRIMES);
+}
+
+PrimeBuffer::~PrimeBuffer()
+{
+    if (data_) primesieve_free(data_);
+}
+
+// Montgomery helper: inverse of odd n modulo 2^64 by Newton iteration
+static inline uint64_t montgomery_inverse(uint64_t n)
+{
+    uint64_t inv = n; // Correct to 3 bits for odd n, each step doubles the precision
+    for (int i = 0; i < 5; ++i)
+    {
+        inv *= 2 - n * inv;
+    }
+    return inv;
+}
+
+// Montgomery helper: a * b * 2^-64 mod n for a, b < n (n odd)
+static inline uint64_t montgomery_mul(uint64_t a, uint64_t b, uint64_t n, uint64_t n_inv)
+{
+    unsigned __int128 t = (unsigned __int128)a * b;
+    uint64_t m = (uint64_t)t * n_inv;
+    uint64_t t_hi = (uint64_t)(t >> 64);
+    uint64_t mn_hi = (uint64_t)(((unsigned __int128)m * n) >> 64);
+    return t_hi >= mn_hi ? t_hi - mn_hi : t_hi - mn_hi + n;
+}
+
+// Utility function to test a single number for primality (deterministic Miller-Rabin
+// over the full 64-bit range using the 7 Sinclair witnesses and Montgomery arithmetic)
+bool is_prime(unsigned long long n)
+{
+    static const uint64_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if (n < 2) return false;
+    for (uint64_t p : small_primes)
+    {
+        if (n % p == 0) return n == p;
+    }
+    if (n < 37 * 37) return true;
+
+    // Write n - 1 = d * 2^s with d odd
+    uint64_t d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
+
+    uint64_t n_inv = montgomery_inverse(n);
+    uint64_t one = (0 - (uint64_t)n) % n;                             // 2^64 mod n
+    uint64_t r2 = (uint64_t)(((unsigned __int128)one * one) % n);     // 2^128 mod n
+    uint64_t minus_one = n - one;
+
+    static const uint64_t witnesses[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (uint64_t a : witnesses)
+    {
+        a %= n;
+        if (a == 0) continue;
+
+        // x = a^d mod n in Montgomery form
+        uint64_t base = montgomery_mul(a, r2, n, n_inv);
+        uint64_t x = one;
+        for (uint64_t e = d; e > 0; e >>= 1)
+        {
+            if (e & 1) x = montgomery_mul(x, base, n, n_inv);
+            base = montgomery_mul(base, base, n, n_inv);
+        }
+
+        if (x == one || x == minus_one) continue;
+
+        bool composite = true;
+        for (int r = 1; r < s; ++r)
+        {
+            x = montgomery_mul(x, x, n, n_inv);
+            if (x == minus_one)
+            {
+                composite = false;
+                break;
+            }
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// Montgomery helper: full 256-bit product of two 128-bit values
+static inline void mul_128x128(rtp_u128 a, rtp_u128 b, rtp_u128 &hi, rtp_u128 &lo)
+{
+    const rtp_u128 mask = ~(uint64_t)0;
+    rtp_u128 a_lo = a & mask, a_hi = a >> 64;
+    rtp_u128 b_lo = b & mask, b_hi = b >> 64;
+
+    rtp_u128 ll = a_lo * b_lo;
+    rtp_u128 lh = a_lo * b_hi;
+    rtp_u128 hl = a_hi * b_lo;
+    rtp_u128 hh = a_hi * b_hi;
+
+    rtp_u128 middle = (ll >> 64) + (lh & mask) + (hl & mask);
+    lo = (middle << 64) | (ll & mask);
+    hi = hh + (lh >> 64) + (hl >> 64) + (middle >> 64);
+}
+
+// Montgomery helper: a * b * 2^-128 mod n for a, b < n (n odd), same reduction as montgomery_mul
+static inline rtp_u128 montgomery_mul_128(rtp_u128 a, rtp_u128 b, rtp_u128 n, rtp_u128 n_inv)
+{
+    rtp_u128 t_hi, t_lo, mn_hi, mn_lo;
+    mul_128x128(a, b, t_hi, t_lo);
+    mul_128x128(t_lo * n_inv, n, mn_hi, mn_lo);
+    return t_hi >= mn_hi ? t_hi - mn_hi : t_hi - mn_hi + n;
+}
+
+// Montgomery arithmetic modulo one odd 128-bit n, with values kept in Montgomery form (x * 2^128 mod n)
+struct Montgomery128
+{
+    rtp_u128 n;
+    rtp_u128 n_inv; // n^-1 mod 2^128
+    rtp_u128 one;   // 2^128 mod n
+    rtp_u128 r2;    // 2^256 mod n
+
+    explicit Montgomery128(rtp_u128 modulus) : n(modulus), n_inv(modulus)
+    {
+        for (int i = 0; i < 6; ++i) // Correct to 3 bits, 6 Newton steps reach 128
+        {
+            n_inv *= 2 - n * n_inv;
+        }
+        one = (0 - n) % n;
+        r2 = one; // 2^256 mod n by 128 modular doublings
+        for (int i = 0; i < 128; ++i)
+        {
+            r2 = add(r2, r2);
+        }
+    }
+
+    rtp_u128 mul(rtp_u128 a, rtp_u128 b) const { return montgomery_mul_128(a, b, n, n_inv); }
+    rtp_u128 add(rtp_u128 a, rtp_u128 b) const { return a >= n - b ? a - (n - b) : a + b; }
+    rtp_u128 sub(rtp_u128 a, rtp_u128 b) const { return a >= b ? a - b : a + (n - b); }
+
+    // a / 2 mod n without overflowing: for odd a, (a + n) / 2 = a / 2 + n / 2 + 1
+    rtp_u128 half(rtp_u128 a) const { return (a & 1) ? (a >> 1) + (n >> 1) + 1 : a >> 1; }
+
+    // Montgomery form of a small signed value (|v| < n)
+    rtp_u128 from_signed(long long v) const
+    {
+        rtp_u128 magnitude = v < 0 ? (rtp_u128)(-v) : (rtp_u128)v;
+        return mul(v < 0 ? n - magnitude : magnitude, r2);
+    }
+};
+
+// Utility function to compute the Jacobi symbol (a / n) for odd n
+static int jacobi_u128(rtp_u128 a, rtp_u128 n)
+{
+    int result = 1;
+    a %= n;
+    while (a != 0)
+    {
+        while ((a & 1) == 0)
+        {
+            a >>= 1;
+            unsigned r = (unsigned)(n & 7);
+            if (r == 3 || r == 5) result = -result;
+        }
+        rtp_u128 t = a;
+        a = n;
+        n = t;
+        if ((a & 3) == 3 && (n & 3) == 3) result = -result;
+        a %= n;
+    }
+    return n == 1 ? result : 0;
+}
+
+// Utility function to compute floor(sqrt(n)) by Newton iteration from a power of two above the root
+static rtp_u128 isqrt_u128(rtp_u128 n)
+{
+    if (n < 2) return n;
+    uint64_t hi = (uint64_t)(n >> 64);
+    int bits = hi ? 128 - __builtin_clzll(hi) : 64 - __builtin_clzll((uint64_t)n);
+    rtp_u128 x = (rtp_u128)1 << ((bits + 1) / 2);
+    for (;;)
+    {
+        rtp_u128 y = (x + n / x) >> 1;
+        if (y >= x) return x;
+        x = y;
+    }
+}
+
+// Helper function for the strong Miller-Rabin test to base 2 (the first half of BPSW)
+static bool is_strong_probable_prime_base2(const Montgomery128 &m)
+{
+    rtp_u128 d = m.n - 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
+
+    rtp_u128 minus_one = m.n - m.one;
+    rtp_u128 base = m.add(m.one, m.one);
+    rtp_u128 x = m.one;
+    for (rtp_u128 e = d; e > 0; e >>= 1)
+    {
+        if (e & 1) x = m.mul(x, base);
+        base = m.mul(base, base);
+    }
+    if (x == m.one || x == minus_one) return true;
+
+    for (int r = 1; r < s; ++r)
+    {
+        x = m.mul(x, x);
+        if (x == minus_one) return true;
+    }
+    return false;
+}
+
+// Helper function for the strong Lucas test with Selfridge's parameters (the second half of BPSW):
+// D is the first of 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and Q = (1 - D) / 4
+static bool is_strong_lucas_probable_prime(const Montgomery128 &m)
+{
+    rtp_u128 n = m.n;
+    rtp_u128 root = isqrt_u128(n);
+    if (root * root == n) return false; // No suitable D exists for perfect squares
+
+    long long D = 5;
+    for (;;)
+    {
+        rtp_u128 magnitude = D < 0 ? (rtp_u128)(-D) : (rtp_u128)D;
+        int j = jacobi_u128(D < 0 ? n - magnitude % n : magnitude, n);
+        if (j == -1) break;
+        if (j == 0 && magnitude != n) return false; // D shares a factor with n
+        D = D < 0 ? -D + 2 : -(D + 2);
+    }
+
+    rtp_u128 Dm = m.from_signed(D);
+    rtp_u128 Q = m.from_signed((1 - D) / 4);
+
+    // n + 1 = d * 2^s with d odd (n + 1 cannot overflow: 2^128 - 1 is divisible by 3)
+    rtp_u128 d = n + 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
+
+    // Walk the bits of d from the top: U_1 = 1, V_1 = P = 1, then double (and add one) per bit
+    int top = 127;
+    while (((d >> top) & 1) == 0) top--;
+    rtp_u128 U = m.one;
+    rtp_u128 V = m.one;
+    rtp_u128 Qk = Q;
+    for (int bit = top - 1; bit >= 0; --bit)
+    {
+        U = m.mul(U, V);
+        V = m.sub(m.mul(V, V), m.add(Qk, Qk));
+        Qk = m.mul(Qk, Qk);
+        if ((d >> bit) & 1)
+        {
+            rtp_u128 next_U = m.half(m.add(U, V));
+            V = m.half(m.add(m.mul(Dm, U), V));
+            U = next_U;
+            Qk = m.mul(Qk, Q);
+        }
+    }
+    if (U == 0 || V == 0) return true;
+
+    for (int r = 1; r < s; ++r)
+    {
+        V = m.sub(m.mul(V, V), m.add(Qk, Qk));
+        Qk = m.mul(Qk, Qk);
+        if (V == 0) return true;
+    }
+    return false;
+}
+
+// Utility function to test a 128-bit number for primality: values that fit in 64 bits take the
+// deterministic kernel, larger ones run BPSW (strong base-2 Miller-Rabin plus a strong Lucas test)
+// in 128-bit Montgomery form, which has no known counterexample
+bool is_prime_u128(rtp_u128 n)
+{
+    if ((n >> 64) == 0) return is_prime((unsigned long long)n);
+
+    static const uint64_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (uint64_t p : small_primes)
+    {
+        if (n % p == 0) return false;
+    }
+
+    Montgomery128 m(n);
+    return is_strong_probable_prime_base2(m) && is_strong_lucas_probable_prime(m);
+}
+
+// Fixed-width unsigned integer of Limbs 64-bit limbs (least significant first), for truncation
+// trees that outgrow 128 bits
+template <int Limbs>
+struct BigUInt
+{
+    uint64_t limb[Limbs];
+};
+
+// Widest BigUInt the tree expanders promote to (512 bits)
+static const int kMaxLimbs = 8;
+
+// Utility function to widen a value to Limbs limbs
+template <int Limbs>
+static inline BigUInt<Limbs> big_from_u128(rtp_u128 value)
+{
+    BigUInt<Limbs> result = {};
+    result.limb[0] = (uint64_t)value;
+    result.limb[1] = (uint64_t)(value >> 64);
+    return result;
+}
+
+template <int To, int From>
+static inline BigUInt<To> big_widen(const BigUInt<From> &value)
+{
+    BigUInt<To> result = {};
+    for (int i = 0; i < From; ++i)
+    {
+        result.limb[i] = value.limb[i];
+    }
+    return result;
+}
+
+template <int Limbs>
+static inline bool big_equal(const BigUInt<Limbs> &a, const BigUInt<Limbs> &b)
+{
+    for (int i = 0; i < Limbs; ++i)
+    {
+        if (a.limb[i] != b.limb[i]) return false;
+    }
+    return true;
+}
+
+template <int Limbs>
+static inline bool big_less(const BigUInt<Limbs> &a, const BigUInt<Limbs> &b)
+{
+    for (int i = Limbs - 1; i >= 0; --i)
+    {
+        if (a.limb[i] != b.limb[i]) return a.limb[i] < b.limb[i];
+    }
+    return false;
+}
+
+// Utility function for a -= b, returns the borrow out
+template <int Limbs>
+static inline uint64_t big_sub(BigUInt<Limbs> &a, const BigUInt<Limbs> &b)
+{
+    uint64_t borrow = 0;
+    for (int i = 0; i < Limbs; ++i)
+    {
+        rtp_u128 diff = (rtp_u128)a.limb[i] - b.limb[i] - borrow;
+        a.limb[i] = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+    return borrow;
+}
+
+// Utility function for a += b, returns the carry out
+template <int Limbs>
+static inline uint64_t big_add(BigUInt<Limbs> &a, const BigUInt<Limbs> &b)
+{
+    uint64_t carry = 0;
+    for (int i = 0; i < Limbs; ++i)
+    {
+        rtp_u128 sum = (rtp_u128)a.limb[i] + b.limb[i] + carry;
+        a.limb[i] = (uint64_t)sum;
+        carry = (uint64_t)(sum >> 64);
+    }
+    return carry;
+}
+
+// Utility function for a = a * m + c, returns the carry out (non-zero when the result overflowed)
+template <int Limbs>
+static inline uint64_t big_mul_add_small(BigUInt<Limbs> &a, uint64_t m, uint64_t c)
+{
+    uint64_t carry = c;
+    for (int i = 0; i < Limbs; ++i)
+    {
+        rtp_u128 product = (rtp_u128)a.limb[i] * m + carry;
+        a.limb[i] = (uint64_t)product;
+        carry = (uint64_t)(product >> 64);
+    }
+    return carry;
+}
+
+template <int Limbs>
+static inline uint64_t big_mod_small(const BigUInt<Limbs> &a, uint64_t p)
+{
+    rtp_u128 remainder = 0;
+    for (int i = Limbs - 1; i >= 0; --i)
+    {
+        remainder = ((remainder << 64) | a.limb[i]) % p;
+    }
+    return (uint64_t)remainder;
+}
+
+// Montgomery arithmetic modulo one odd BigUInt n (R = 2^(64 * Limbs)), multiplying with CIOS
+template <int Limbs>
+struct MontgomeryBig
+{
+    BigUInt<Limbs> n;
+    uint64_t n_prime;     // -n^-1 mod 2^64
+    BigUInt<Limbs> one;   // R mod n
+    BigUInt<Limbs> r2;    // R^2 mod n
+
+    explicit MontgomeryBig(const BigUInt<Limbs> &modulus) : n(modulus)
+    {
+        uint64_t inv = n.limb[0]; // Correct to 3 bits, 5 Newton steps reach 64
+        for (int i = 0; i < 5; ++i)
+        {
+            inv *= 2 - n.limb[0] * inv;
+        }
+        n_prime = 0 - inv;
+
+        // R mod n and R^2 mod n by modular doublings of 1
+        one = BigUInt<Limbs>{};
+        one.limb[0] = 1;
+        for (int i = 0; i < 64 * Limbs; ++i)
+        {
+            one = add(one, one);
+        }
+        r2 = one;
+        for (int i = 0; i < 64 * Limbs; ++i)
+        {
+            r2 = add(r2, r2);
+        }
+    }
+
+    BigUInt<Limbs> add(BigUInt<Limbs> a, const BigUInt<Limbs> &b) const
+    {
+        uint64_t carry = big_add(a, b);
+        if (carry || !big_less(a, n)) big_sub(a, n);
+        return a;
+    }
+
+    BigUInt<Limbs> mul(const BigUInt<Limbs> &a, const BigUInt<Limbs> &b) const
+    {
+        uint64_t t[Limbs + 2] = {};
+        for (int i = 0; i < Limbs; ++i)
+        {
+            rtp_u128 carry = 0;
+            for (int j = 0; j < Limbs; ++j)
+            {
+                rtp_u128 sum = (rtp_u128)a.limb[j] * b.limb[i] + t[j] + carry;
+                t[j] = (uint64_t)sum;
+                carry = sum >> 64;
+            }
+            rtp_u128 sum = (rtp_u128)t[Limbs] + carry;
+            t[Limbs] = (uint64_t)sum;
+            t[Limbs + 1] = (uint64_t)(sum >> 64);
+
+            // Add m * n so the lowest limb cancels, then shift down one limb
+            uint64_t m = t[0] * n_prime;
+            sum = (rtp_u128)m * n.limb[0] + t[0];
+            carry = sum >> 64;
+            for (int j = 1; j < Limbs; ++j)
+            {
+                sum = (rtp_u128)m * n.limb[j] + t[j] + carry;
+                t[j - 1] = (uint64_t)sum;
+                carry = sum >> 64;
+            }
+            sum = (rtp_u128)t[Limbs] + carry;
+            t[Limbs - 1] = (uint64_t)sum;
+            t[Limbs] = t[Limbs + 1] + (uint64_t)(sum >> 64);
+        }
+
+        BigUInt<Limbs> result;
+        for (int i = 0; i < Limbs; ++i)
+        {
+            result.limb[i] = t[i];
+        }
+        if (t[Limbs] != 0 || !big_less(result, n)) big_sub(result, n);
+        return result;
+    }
+};
+
+// Utility function to test a BigUInt for primality: values that fit in 128 bits take is_prime_u128,
+// larger ones run Miller-Rabin in Montgomery form over the first 12 prime bases (a probable-prime test)
+template <int Limbs>
+static bool is_probable_prime_big(const BigUInt<Limbs> &n)
+{
+    bool wide = false;
+    for (int i = 2; i < Limbs; ++i)
+    {
+        wide = wide || n.limb[i] != 0;
+    }
+    if (!wide) return is_prime_u128(((rtp_u128)n.limb[1] << 64) | n.limb[0]);
+
+    static const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (uint64_t p : bases)
+    {
+        if (big_mod_small(n, p) == 0) return false;
+    }
+
+    // n - 1 = d * 2^s with d odd (n is odd, so subtracting 1 only clears the lowest bit)
+    BigUInt<Limbs> n_minus_1 = n;
+    n_minus_1.limb[0] -= 1;
+    int s = 0;
+    while (((n_minus_1.limb[s / 64] >> (s % 64)) & 1) == 0) s++;
+    int top = 64 * Limbs - 1;
+    while (((n_minus_1.limb[top / 64] >> (top % 64)) & 1) == 0) top--;
+
+    MontgomeryBig<Limbs> m(n);
+    BigUInt<Limbs> minus_one = n;
+    big_sub(minus_one, m.one);
+
+    for (uint64_t a : bases)
+    {
+        BigUInt<Limbs> base = {};
+        base.limb[0] = a;
+        base = m.mul(base, m.r2);
+
+        // x = base^d: the bits of n - 1 from the top down to bit s are exactly the bits of d
+        BigUInt<Limbs> x = m.one;
+        for (int bit = top; bit >= s; --bit)
+        {
+            x = m.mul(x, x);
+            if ((n_minus_1.limb[bit / 64] >> (bit % 64)) & 1) x = m.mul(x, base);
+        }
+        if (big_equal(x, m.one) || big_equal(x, minus_one)) continue;
+
+        bool composite = true;
+        for (int r = 1; r < s && composite; ++r)
+        {
+            x = m.mul(x, x);
+            if (big_equal(x, minus_one)) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// Helper function to widen count limbs into the smallest BigUInt<Limbs> holding them and test it
+template <int Limbs>
+static bool is_probable_prime_padded(const uint64_t *limbs, int count)
+{
+    BigUInt<Limbs> n = {};
+    for (int i = 0; i < count; ++i)
+    {
+        n.limb[i] = limbs[i];
+    }
+    return is_probable_prime_big(n);
+}
+
+bool is_probable_prime_limbs(const uint64_t *limbs, int count)
+{
+    if (count < 1 || count > kMaxLimbs) return false;
+    if (count <= 3) return is_probable_prime_padded<3>(limbs, count);
+    if (count <= 4) return is_probable_prime_padded<4>(limbs, count);
+    if (count <= 6) return is_probable_prime_padded<6>(limbs, count);
+    return is_probable_prime_padded<8>(limbs, count);
+}
+
+// Helper function to find each digit window of the sorted prime array in one pass of
+// binary searches: primes with k digits live in [digit_offsets[k - 1], digit_offsets[k])
+std::vector<size_t> find_digit_windows(PrimeSpan all_primes_array, int digits)
+{
+    std::vector<size_t> digit_offsets(digits + 1, 0);
+    const unsigned long long *first = all_primes_array.begin();
+    for (int k = 1; k <= digits; ++k)
+    {
+        first = std::lower_bound(first, all_primes_array.end(), power_of_10(k));
+        digit_offsets[k] = (size_t)(first - all_primes_array.begin());
+    }
+    return digit_offsets;
+}
+
+// Helper function to check every right truncation of a prime against the prime bitmap
+static inline bool is_right_truncatable(unsigned long long current_prime, const Wheel30Bitset &prime_bitset)
+{
+    unsigned long long temp_prime = current_prime;
+
+    while (temp_prime > 0) // Loop until the number becomes 0 (all digits removed)
+    {
+        // Check if the current truncated number is prime using bitset
+        if (!prime_bitset.test(temp_prime)) return false; // Not a right-truncatable prime
+
+        temp_prime /= 10; // Remove the rightmost digit
+    }
+    return true;
+}
+
+// Composite function to calculate total number of right-truncatable primes
+int count_right_trunc_primes(PrimeSpan all_primes_array,
+                             const std::vector<size_t> &digit_offsets,
+                             std::vector<uint64_t> &primes_per_digit,
+                             const Wheel30Bitset &prime_bitset, int digits)
+{
+    if (digits < 1 || digits > RTP_MAX_SIEVE_DIGITS) return -1;
+
+    // Iterate through primes of the specified "digits" length only
+    int right_truncatable_count = 0;
+    size_t first = digit_offsets[digits - 1];
+    size_t last  = digit_offsets[digits];
+    primes_per_digit[digits] = last - first;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        if (is_right_truncatable(all_primes_array[i], prime_bitset)) right_truncatable_count++;
+    }
+
+    return right_truncatable_count;
+}
+
+// Helper function to count primes and right-truncatable primes for the digit bands
+// first_band..last_band at once: the primes of those bands are cut into one contiguous chunk
+// per thread, each chunk is counted per digit band independently, and the results are merged
+static int count_bands_parallel(PrimeSpan all_primes_array,
+                                const std::vector<size_t> &digit_offsets,
+                                std::vector<uint64_t> &primes_per_digit,
+                                std::vector<uint64_t> &right_trunc_per_digit,
+                                const Wheel30Bitset &prime_bitset, int first_band, int last_band, int threads)
+{
+    if (threads < 1) threads = 1;
+
+    std::vector<std::vector<uint64_t>> per_thread(threads, std::vector<uint64_t>(last_band + 1, 0));
+    std::vector<std::thread> workers;
+    size_t band_primes_first = digit_offsets[first_band - 1];
+    size_t band_primes = digit_offsets[last_band] - band_primes_first;
+
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            size_t chunk_first = band_primes_first + band_primes * t / threads;
+            size_t chunk_last  = band_primes_first + band_primes * (t + 1) / threads;
+            std::vector<uint64_t> &counts = per_thread[t];
+
+            // Walk the digit bands that intersect this chunk
+            for (int k = first_band; k <= last_band; ++k)
+            {
+                size_t first = std::max(chunk_first, digit_offsets[k - 1]);
+                size_t last  = std::min(chunk_last, digit_offsets[k]);
+                for (size_t i = first; i < last; ++i)
+                {
+                    if (is_right_truncatable(all_primes_array[i], prime_bitset)) counts[k]++;
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    int total_count = 0;
+    for (int k = first_band; k <= last_band; ++k)
+    {
+        primes_per_digit[k] = digit_offsets[k] - digit_offsets[k - 1];
+        right_trunc_per_digit[k] = 0;
+        for (const std::vector<uint64_t> &counts : per_thread)
+        {
+            right_trunc_per_digit[k] += counts[k];
+        }
+        total_count += (int)right_trunc_per_digit[k];
+    }
+    return total_count;
+}
+
+// Composite function to count primes and right-truncatable primes for every digit length at once
+int count_right_trunc_primes_parallel(PrimeSpan all_primes_array,
+                                      const std::vector<size_t> &digit_offsets,
+                                      std::vector<uint64_t> &primes_per_digit,
+                                      std::vector<uint64_t> &right_trunc_per_digit,
+                                      const Wheel30Bitset &prime_bitset, int digits, int threads)
+{
+    if (digits < 1 || digits > RTP_MAX_SIEVE_DIGITS) return -1;
+    return count_bands_parallel(all_primes_array, digit_offsets, primes_per_digit, right_trunc_per_digit,
+                                prime_bitset, 1, digits, threads);
+}
+
+// Composite function to count right-truncatable primes of one digit length using a memo
+// bitmap: a prime p is right-truncatable iff p < 10 or right_trunc_bitset[p / 10] is set.
+// Must be called in ascending digit order so every parent's bit is final before its children
+int count_right_trunc_primes_memo(PrimeSpan all_primes_array,
+                                  const std::vector<size_t> &digit_offsets,
+                                  std::vector<uint64_t> &primes_per_digit,
+                                  Wheel30Bitset &right_trunc_bitset, int digits)
+{
+    if (digits < 1 || digits > RTP_MAX_SIEVE_DIGITS) return -1;
+
+    int right_truncatable_count = 0;
+    size_t first = digit_offsets[digits - 1];
+    size_t last  = digit_offsets[digits];
+    primes_per_digit[digits] = last - first;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        unsigned long long current_prime = all_primes_array[i];
+
+        // One lookup replaces the walk over every prefix
+        if (digits > 1 && !right_trunc_bitset.test(current_prime / 10)) continue;
+
+        right_truncatable_count++;
+        // Only primes that can still be a parent need a bit
+        if (current_prime <= right_trunc_bitset.limit()) right_trunc_bitset.set(current_prime);
+    }
+
+    return right_truncatable_count;
+}
+
+// Composite function to count right-truncatable primes while streaming primes from a
+// primesieve_iterator, so the prime list is never materialized (memory is the memo bitmap,
+// which is extended one band at a time). Stops after the first band without any
+// right-truncatable prime: it has no children, so every longer band is empty too
+int count_right_trunc_primes_stream(std::vector<uint64_t> &primes_per_digit,
+                                    std::vector<uint64_t> &right_trunc_per_digit,
+                                    Wheel30Bitset &right_trunc_bitset, int digits)
+{
+    if (digits < 1 || digits > RTP_MAX_SIEVE_DIGITS) return -1;
+
+    unsigned long long max_end = power_of_10(digits) - 1;
+    unsigned long long band_end = 10; // First number past the current digit length
+    int band = 1;
+
+    if (digits > 1) right_trunc_bitset.extend(band_end - 1);
+
+    primesieve_iterator it;
+    primesieve_init(&it);
+
+    // Primes arrive in ascending order, so every parent is settled before its children
+    uint64_t prime;
+    bool exhausted = false;
+    while ((prime = primesieve_next_prime(&it)) <= max_end)
+    {
+        while (prime >= band_end)
+        {
+            if (right_trunc_per_digit[band] == 0)
+            {
+                exhausted = true;
+                break;
+            }
+            band++;
+            band_end *= 10;
+            if (band < digits) right_trunc_bitset.extend(band_end - 1);
+        }
+        if (exhausted) break;
+
+        primes_per_digit[band]++;
+        if (band > 1 && !right_trunc_bitset.test(prime / 10)) continue;
+
+        right_trunc_per_digit[band]++;
+        if (prime <= right_trunc_bitset.limit()) right_trunc_bitset.set(prime);
+    }
+
+    primesieve_free_iterator(&it);
+
+    int total_count = 0;
+    for (int i = 1; i <= digits; ++i)
+    {
+        total_count += (int)right_trunc_per_digit[i];
+    }
+    return total_count;
+}
+
+// Utility function to find the largest k such that every k-digit number in the given base fits in Word
+template <typename Word>
+constexpr int radix_max_digits(unsigned base)
+{
+    const Word limit = ~(Word)0;
+    Word power = 1;
+    int k = 0;
+    while (power <= limit / base)
+    {
+        power *= base;
+        k++;
+    }
+    // base^(k+1) may be exactly 2^bits (power-of-two bases), in which case base^(k+1) - 1 still fits
+    if (power == limit / base + 1 && limit % base == base - 1) k++;
+    return k;
+}
+
+// Compile-time digit tables for one radix: powers of the base, the digits coprime to it (the only
+// possible last digits of a prime with two or more digits) and the one-digit primes (tree roots)
+template <unsigned Base, typename Word>
+struct RadixTables
+{
+    static constexpr int max_digits = radix_max_digits<Word>(Base);
+
+    Word power[max_digits];  // power[k] = Base^k, enough to prepend a digit to any shorter number
+    unsigned coprime_digits[Base];
+    int coprime_count;
+    unsigned roots[Base];
+    int root_count;
+};
+
+template <unsigned Base, typename Word>
+constexpr RadixTables<Base, Word> build_radix_tables()
+{
+    RadixTables<Base, Word> tables{};
+    Word power = 1;
+    for (int k = 0; k < RadixTables<Base, Word>::max_digits; ++k)
+    {
+        tables.power[k] = power;
+        power *= Base;
+    }
+    for (unsigned d = 1; d < Base; ++d)
+    {
+        unsigned a = d, b = Base;
+        while (b != 0)
+        {
+            unsigned t = a % b;
+            a = b;
+            b = t;
+        }
+        if (a == 1) tables.coprime_digits[tables.coprime_count++] = d;
+        if (rtp_constexpr_is_prime(d)) tables.roots[tables.root_count++] = d;
+    }
+    return tables;
+}
+
+// Utility function to find the largest k such that every k-digit number in the given base fits in
+// a BigUInt of the given limb count (base^k <= 2^(64 * limbs), tracked in 32-bit digits)
+constexpr int big_radix_max_digits(int limbs, unsigned base)
+{
+    uint32_t power[2 * kMaxLimbs + 1] = {1};
+    int k = 0;
+    for (;;)
+    {
+        uint64_t carry = 0;
+        uint32_t next[2 * kMaxLimbs + 1] = {};
+        for (int i = 0; i <= 2 * limbs; ++i)
+        {
+            uint64_t t = (uint64_t)power[i] * base + carry;
+            next[i] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        bool below = true; // base^(k+1) == 2^(64 * limbs) exactly still fits
+        for (int i = 0; i < 2 * limbs; ++i)
+        {
+            below = below && next[i] == 0;
+        }
+        if (next[2 * limbs] > 1 || (next[2 * limbs] == 1 && !below)) return k;
+        for (int i = 0; i <= 2 * limbs; ++i)
+        {
+            power[i] = next[i];
+        }
+        k++;
+    }
+}
+
+// Truncation policies for the shared tree expander, specialized per radix so digit arithmetic
+// works on compile-time constants. Each one lists the roots, says how a node with the given
+// digit length grows children (every child is tested with the shared primality oracle) and
+// whether the node itself is counted
+template <unsigned Base>
+struct RightPolicy
+{
+    typedef rtp_u128 word; // Large bases outgrow 64 bits, is_prime_u128 keeps the 64-bit kernel below 2^64
+    static constexpr RadixTables<Base, word> tables = build_radix_tables<Base, word>();
+    static const int max_digits = RadixTables<Base, word>::max_digits; // Deepest level that fits word
+    static const int digit_limit = big_radix_max_digits(kMaxLimbs, Base); // Deepest level with BigUInt
+
+    // Append a digit coprime to the base (any other last digit makes the child divisible by it)
+    static int children(word value, int, word *out)
+    {
+        int count = 0;
+        for (int i = 0; i < tables.coprime_count; ++i)
+        {
+            word child = value * Base + tables.coprime_digits[i];
+            if (is_prime_u128(child)) out[count++] = child;
+        }
+        return count;
+    }
+
+    static bool counted(word, int) { return true; }
+
+    // Grow the children of a node at max_digits, which no longer fit word
+    static void grow_wider(word value, int depth, int digits, std::vector<uint64_t> &per_digit);
+};
+
+// Right-truncatable subtrees past 128 bits, in the narrowest BigUInt that holds each level: a node
+// is promoted to the next limb count only when its children would no longer fit
+template <unsigned Base, int Limbs>
+struct WideRightTree
+{
+    static const int max_digits = big_radix_max_digits(Limbs, Base);
+    static const int next_limbs = Limbs < 4 ? Limbs + 1 : Limbs + 2; // 3, 4, 6, 8
+
+    static void expand(const BigUInt<Limbs> &value, int depth, int digits, std::vector<uint64_t> &per_digit)
+    {
+        per_digit[depth]++;
+        if (depth < digits) grow(value, depth, digits, per_digit);
+    }
+
+    static void grow(const BigUInt<Limbs> &value, int depth, int digits, std::vector<uint64_t> &per_digit)
+    {
+        if (depth == max_digits)
+        {
+            if constexpr (Limbs < kMaxLimbs)
+            {
+                WideRightTree<Base, next_limbs>::grow(big_widen<next_limbs>(value), depth, digits, per_digit);
+            }
+            return;
+        }
+
+        const RadixTables<Base, rtp_u128> &tables = RightPolicy<Base>::tables;
+        for (int i = 0; i < tables.coprime_count; ++i)
+        {
+            BigUInt<Limbs> child = value;
+            big_mul_add_small(child, Base, tables.coprime_digits[i]);
+            if (is_probable_prime_big(child)) expand(child, depth + 1, digits, per_digit);
+        }
+    }
+};
+
+template <unsigned Base>
+void RightPolicy<Base>::grow_wider(word value, int depth, int digits, std::vector<uint64_t> &per_digit)
+{
+    WideRightTree<Base, 3>::grow(big_from_u128<3>(value), depth, digits, per_digit);
+}
+
+template <unsigned Base>
+struct LeftPolicy
+{
+    typedef rtp_u128 word; // The base-10 tree reaches 24 digits, past 64 bits
+    static constexpr RadixTables<Base, word> tables = build_radix_tables<Base, word>();
+    static const int max_digits = RadixTables<Base, word>::max_digits;
+    static const int digit_limit = max_digits;
+
+    // Prepend a non-zero digit (a zero would make the next truncation drop two digits)
+    static int children(word value, int length, word *out)
+    {
+        int count = 0;
+        word scale = tables.power[length];
+        for (unsigned d = 1; d < Base; ++d)
+        {
+            word child = d * scale + value;
+            if (is_prime_u128(child)) out[count++] = child;
+        }
+        return count;
+    }
+
+    static bool counted(word, int) { return true; }
+};
+
+// Two-sided primes are the right-truncatable primes that are also left-truncatable, so the
+// right tree is grown and each node's suffixes are rebuilt digit by digit from the right
+template <unsigned Base>
+struct TwoSidedPolicy : RightPolicy<Base>
+{
+    typedef rtp_u128 word;
+    static const int digit_limit = RightPolicy<Base>::max_digits; // Every two-sided tree dies out far earlier
+
+    static bool counted(word value, int length)
+    {
+        word rest = value;
+        word suffix = 0;
+        word scale = 1;
+        for (int k = 1; k < length; ++k)
+        {
+            word digit = rest % Base;
+            rest /= Base;
+            if (digit == 0) return false; // A zero digit drops two digits in one truncation
+            suffix += digit * scale;
+            scale *= Base;
+            if (!is_prime_u128(suffix)) return false;
+        }
+        return true;
+    }
+};
+
+// Helper function to grow the truncation tree below one node
+template <typename Policy>
+static void expand_truncation_tree(typename Policy::word value, int depth, int digits, std::vector<uint64_t> &per_digit)
+{
+    if (Policy::counted(value, depth)) per_digit[depth]++;
+    if (depth == digits) return;
+    if constexpr (Policy::digit_limit > Policy::max_digits)
+    {
+        if (depth == Policy::max_digits) return Policy::grow_wider(value, depth, digits, per_digit);
+    }
+
+    typename Policy::word children[RTP_MAX_BASE];
+    int child_count = Policy::children(value, depth, children);
+    for (int i = 0; i < child_count; ++i)
+    {
+        expand_truncation_tree<Policy>(children[i], depth + 1, digits, per_digit);
+    }
+}
+
+// Everything a work-stealing pool needs to grow one base's tree, as plain data and function pointers,
+// so the pool is only instantiated once per word type rather than once per policy and base
+template <typename Word>
+struct TreeSpec
+{
+    int (*children)(Word, int, Word *);
+    bool (*counted)(Word, int);
+    void (*grow_wider)(Word, int, int, std::vector<uint64_t> &); // NULL when the tree ends at word_digits
+    const unsigned *roots;
+    int root_count;
+    int word_digits; // Deepest level that fits Word
+    int max_digits;  // Deepest level overall
+};
+
+template <typename Policy>
+static TreeSpec<typename Policy::word> make_tree_spec()
+{
+    TreeSpec<typename Policy::word> spec = {&Policy::children, &Policy::counted, NULL, Policy::tables.roots,
+                                            Policy::tables.root_count, Policy::max_digits, Policy::digit_limit};
+    if constexpr (Policy::digit_limit > Policy::max_digits) spec.grow_wider = &Policy::grow_wider;
+    return spec;
+}
+
+// Helper function to expand subtrees on a work-stealing pool with per-thread counters merged at
+// the end. Subtrees that outgrow the word are finished serially by the worker that reaches them
+template <typename Word>
+static void expand_truncation_tree_parallel(const TreeSpec<Word> &spec, int digits, int threads, std::vector<uint64_t> &per_digit)
+{
+    struct TreeNode
+    {
+        Word value;
+        int depth;
+    };
+
+    WorkStealingPool<TreeNode> pool(threads);
+    std::vector<std::vector<uint64_t>> per_thread(pool.threads(), std::vector<uint64_t>(digits + 1, 0));
+    std::vector<TreeNode> seeds;
+    for (int i = 0; i < spec.root_count; ++i)
+    {
+        seeds.push_back(TreeNode{spec.roots[i], 1});
+    }
+
+    pool.run(seeds, [&](const TreeNode &node, int worker) {
+        if (spec.counted(node.value, node.depth)) per_thread[worker][node.depth]++;
+        if (node.depth == digits) return;
+        if (node.depth == spec.word_digits) return spec.grow_wider(node.value, node.depth, digits, per_thread[worker]);
+
+        Word child_values[RTP_MAX_BASE];
+        int child_count = spec.children(node.value, node.depth, child_values);
+        for (int i = 0; i < child_count; ++i)
+        {
+            pool.push(worker, TreeNode{child_values[i], node.depth + 1});
+        }
+    });
+
+    for (const std::vector<uint64_t> &counts : per_thread)
+    {
+        for (int i = 1; i <= digits; ++i)
+        {
+            per_digit[i] += counts[i];
+        }
+    }
+}
+
+// Composite function to count one policy's primes by growing its tree from the one-digit primes,
+// recursively or on the work-stealing pool when several threads are given
+template <typename Policy>
+static int count_truncation_tree(std::vector<uint64_t> &per_digit, int digits, int threads)
+{
+    if (digits < 1 || digits > Policy::digit_limit) return -1;
+
+    if (threads <= 1)
+    {
+        for (int i = 0; i < Policy::tables.root_count; ++i)
+        {
+            expand_truncation_tree<Policy>(Policy::tables.roots[i], 1, digits, per_digit);
+        }
+    }
+    else
+    {
+        expand_truncation_tree_parallel(make_tree_spec<Policy>(), digits, threads, per_digit);
+    }
+
+    int total_count = 0;
+    for (int i = 1; i <= digits; ++i)
+    {
+        total_count += (int)per_digit[i];
+    }
+    return total_count;
+}
+
+// One prebuilt specialization of the tree engine: policy x base
+struct TreeEngine
+{
+    int (*count)(std::vector<uint64_t> &per_digit, int digits, int threads);
+    int max_digits;
+};
+
+template <template <unsigned> class Policy, size_t... I>
+static const TreeEngine *tree_engines(std::index_sequence<I...>)
+{
+    static const TreeEngine engines[] = {
+        {&count_truncation_tree<Policy<RTP_MIN_BASE + I>>, Policy<RTP_MIN_BASE + I>::digit_limit}...};
+    return engines;
+}
+
+// Helper function to dispatch a runtime (policy, base) pair to its specialization, NULL when unsupported
+static const TreeEngine *find_tree_engine(RtpPolicy policy, int base)
+{
+    if (base < RTP_MIN_BASE || base > RTP_MAX_BASE) return NULL;
+
+    typedef std::make_index_sequence<RTP_MAX_BASE - RTP_MIN_BASE + 1> bases;
+    switch (policy)
+    {
+    case RTP_POLICY_RIGHT:     return &tree_engines<RightPolicy>(bases())[base - RTP_MIN_BASE];
+    case RTP_POLICY_LEFT:      return &tree_engines<LeftPolicy>(bases())[base - RTP_MIN_BASE];
+    case RTP_POLICY_TWO_SIDED: return &tree_engines<TwoSidedPolicy>(bases())[base - RTP_MIN_BASE];
+    }
+    return NULL;
+}
+
+int count_truncatable_primes_tree(RtpPolicy policy, std::vector<uint64_t> &per_digit, int digits, int threads, int base)
+{
+    const TreeEngine *engine = find_tree_engine(policy, base);
+    return engine ? engine->count(per_digit, digits, threads) : -1;
+}
+
+// Composite function to count right-truncatable primes by growing the tree from 2, 3, 5, 7
+// (work scales with the size of the tree instead of with 10^digits)
+int count_right_trunc_primes_tree(std::vector<uint64_t> &right_trunc_per_digit, int digits)
+{
+    return count_truncation_tree<RightPolicy<10>>(right_trunc_per_digit, digits, 1);
+}
+
+// Composite function to count right-truncatable primes by expanding subtrees on a
+// work-stealing pool, with per-thread counters merged at the end
+int count_right_trunc_primes_tree_parallel(std::vector<uint64_t> &right_trunc_per_digit, int digits, int threads)
+{
+    return count_truncation_tree<RightPolicy<10>>(right_trunc_per_digit, digits, threads);
+}
+
+int rtp_max_digits(RtpPolicy policy, int base)
+{
+    const TreeEngine *engine = find_tree_engine(policy, base);
+    return engine ? engine->max_digits : 0;
+}
+
+// Fixed team of worker threads for short parallel loops: run() cuts [0, count) into one contiguous
+// chunk per thread and returns once every chunk is done, so a loop costs a wake-up, not a spawn
+class ParallelLoop
+{
+public:
+    typedef std::function<void(uint64_t first, uint64_t last)> Body;
+
+    explicit ParallelLoop(int threads) : threads_(threads < 1 ? 1 : threads), body_(NULL), count_(0),
+                                         generation_(0), remaining_(0), stop_(false)
+    {
+        for (int t = 1; t < threads_; ++t)
+        {
+            workers_.emplace_back(&ParallelLoop::work, this, t);
+        }
+    }
+
+    ~ParallelLoop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    int threads() const { return threads_; }
+
+    void run(uint64_t count, const Body &body)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            body_ = &body;
+            count_ = count;
+            remaining_ = threads_ - 1;
+            generation_++;
+        }
+        start_.notify_all();
+
+        // The calling thread takes the first chunk
+        body(0, count / threads_);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return remaining_ == 0; });
+    }
+
+private:
+    void work(int t)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            const Body *body;
+            uint64_t count;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [this, seen]() { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                body = body_;
+                count = count_;
+            }
+
+            (*body)(count * t / threads_, count * (t + 1) / threads_);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--remaining_ == 0) done_.notify_one();
+        }
+    }
+
+    int threads_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const Body *body_;
+    uint64_t count_;
+    uint64_t generation_;
+    int remaining_;
+    bool stop_;
+};
+
+// Utility function to compute floor(sqrt(n)) exactly
+static uint64_t isqrt_u64(uint64_t n)
+{
+    uint64_t r = (uint64_t)sqrtl((long double)n);
+    while (r > 0 && r > n / r) r--;
+    while ((r + 1) <= n / (r + 1)) r++;
+    return r;
+}
+
+// Utility function to compute x / d when the quotient is below 2^32 (d > isqrt(x)): the double
+// estimate is off by at most one, and the remainder (computed mod 2^64) tells which way
+static inline uint64_t divide_small_quotient(uint64_t x, double x_double, uint64_t d)
+{
+    uint64_t q = (uint64_t)(x_double / (double)d);
+    int64_t rem = (int64_t)(x - q * d);
+    if (rem < 0) return q - 1;
+    if ((uint64_t)rem >= d) return q + 1;
+    return q;
+}
+
+// pi(v) for every v = floor(x / i), the values the Lucy-Hedgehog recurrence visits:
+// small[v] = pi(v) for v <= r = isqrt(x) and large[i] = pi(x / i) for i <= r
+struct PrimePiTable
+{
+    uint64_t x;
+    uint64_t r;
+    std::vector<uint32_t> small; // pi(v) <= v <= 2^32 - 1
+    std::vector<uint64_t> large;
+
+    // v must be floor(x / i) for some i
+    uint64_t pi(uint64_t v) const { return v <= r ? small[v] : large[x / v]; }
+};
+
+// Utility function to estimate the bytes PrimePiTable needs for x, compared against physical memory
+// so an oversized run falls back to primesieve instead of being killed by the kernel
+static bool prime_pi_table_fits(uint64_t x)
+{
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) return true;
+    uint64_t needed = (isqrt_u64(x) + 1) * (sizeof(uint32_t) + sizeof(uint64_t));
+    return needed <= (uint64_t)pages * (uint64_t)page_size / 2;
+}
+
+// Composite function to fill a PrimePiTable with the Lucy-Hedgehog recurrence. Entries start as
+// the count of 2..v and every prime p <= r removes its multiples: S(v) -= S(v / p) - S(p - 1) for
+// each v >= p^2. That is O(x^(3/4) / log x) time and O(x^(1/2)) memory. v / p is only updated in
+// the same round when v >= p^3, so the entries are cut into levels [p^m, p^(m+1)), updated from
+// the highest level down: inside a level every read is final, and the level is split across
+// threads
+static void fill_prime_pi_table(PrimePiTable &table, uint64_t x, int threads)
+{
+    const uint64_t min_parallel = 1 << 15; // Smaller levels cost less than waking the team
+    uint64_t r = isqrt_u64(x);
+    table.x = x;
+    table.r = r;
+    table.small.resize(r + 1);
+    table.large.resize(r + 1);
+    uint32_t *small = table.small.data();
+    uint64_t *large = table.large.data();
+    double x_double = (double)x;
+
+    ParallelLoop team(threads);
+    ParallelLoop::Body init = [&](uint64_t first, uint64_t last) {
+        for (uint64_t v = first + 1; v <= last; ++v)
+        {
+            small[v] = (uint32_t)(v - 1);
+            large[v] = x / v - 1;
+        }
+    };
+    small[0] = 0;
+    large[0] = 0;
+    team.run(r, init);
+
+    std::vector<std::pair<uint64_t, uint64_t>> levels;
+    for (uint64_t p = 2; p <= r; ++p)
+    {
+        if (small[p] == small[p - 1]) continue; // p is composite
+        uint64_t sp = small[p - 1];
+
+        levels.clear();
+        for (uint64_t lo = p * p; lo != 0;)
+        {
+            uint64_t hi = lo > x / p ? x : lo * p - 1;
+            levels.push_back(std::make_pair(lo, hi));
+            lo = hi == x ? 0 : hi + 1;
+        }
+
+        for (size_t l = levels.size(); l-- > 0;)
+        {
+            uint64_t lo = levels[l].first;
+            uint64_t hi = levels[l].second;
+
+            // large[i] holds x / i in [lo, hi] for i in [large_first, large_last]
+            uint64_t large_first = x / (hi + 1) + 1;
+            uint64_t large_last  = std::min(r, x / lo);
+            uint64_t large_count = large_last >= large_first ? large_last - large_first + 1 : 0;
+            // small[v] for v in [lo, min(hi, r)]
+            uint64_t small_last  = std::min(hi, r);
+            uint64_t small_count = small_last >= lo ? small_last - lo + 1 : 0;
+
+            ParallelLoop::Body update = [&](uint64_t first, uint64_t last) {
+                uint64_t k = first;
+                for (; k < last && k < large_count; ++k)
+                {
+                    uint64_t i = large_first + k;
+                    uint64_t d = i * p;
+                    large[i] -= (d <= r ? large[d] : small[divide_small_quotient(x, x_double, d)]) - sp;
+                }
+                if (k >= last) return;
+
+                // Walk v / p incrementally instead of dividing for every entry
+                uint64_t v = lo + (k - large_count);
+                uint64_t v_last = lo + (last - large_count);
+                uint64_t q = v / p;
+                uint64_t next = (q + 1) * p;
+                for (; v < v_last; ++v)
+                {
+                    if (v == next)
+                    {
+                        q++;
+                        next += p;
+                    }
+                    small[v] -= (uint32_t)(small[q] - sp);
+                }
+            };
+
+            uint64_t count = large_count + small_count;
+            if (count >= min_parallel && team.threads() > 1) team.run(count, update);
+            else update(0, count);
+        }
+    }
+}
+
+int rtp_max_prime_count_digits(int base)
+{
+    if (base < RTP_MIN_BASE || base > RTP_MAX_BASE) return 0;
+
+    // Longest length whose numbers fit in 64 bits (base^digits may wrap to exactly 0, and
+    // base^digits - 1 is still right), cut back until the pi(x) tables fit in memory
+    int digits = radix_max_digits<uint64_t>((unsigned)base);
+    std::vector<uint64_t> powers(digits + 1, 1);
+    for (int k = 1; k <= digits; ++k) powers[k] = powers[k - 1] * base;
+    while (digits > 0 && !prime_pi_table_fits(powers[digits] - 1)) digits--;
+    return digits;
+}
+
+uint64_t rtp_prime_pi(uint64_t x, int threads)
+{
+    if (x < 2) return 0;
+    PrimePiTable table;
+    fill_prime_pi_table(table, x, threads);
+    return table.pi(x);
+}
+
+RtpStatus rtp_count_primes_per_digit(std::vector<uint64_t> &primes_per_digit, int first, int last, int base, int threads)
+{
+    int max_digits = rtp_max_prime_count_digits(base);
+    if (max_digits == 0) return RTP_UNSUPPORTED_BASE;
+    if (first < 1 || first > last || last > max_digits) return RTP_INVALID_DIGITS;
+    if (primes_per_digit.size() < (size_t)last + 1) primes_per_digit.resize(last + 1, 0);
+
+    // One Lucy-Hedgehog run at x = base^last - 1 yields every band end, since
+    // floor(x / base^j) = base^(last - j) - 1. base^last may be exactly 2^64, which wraps to 0
+    std::vector<uint64_t> powers(last + 1, 1);
+    for (int k = 1; k <= last; ++k) powers[k] = powers[k - 1] * base;
+    uint64_t x = powers[last] - 1;
+
+    PrimePiTable table;
+    fill_prime_pi_table(table, x, threads);
+    for (int k = first; k <= last; ++k)
+    {
+        primes_per_digit[k] = table.pi(powers[k] - 1) - table.pi(powers[k - 1] - 1);
+    }
+    return RTP_OK;
+}
+
+template <template <unsigned> class Policy, size_t... I>
+static const TreeSpec<typename Policy<10>::word> *tree_specs(std::index_sequence<I...>)
+{
+    static const TreeSpec<typename Policy<10>::word> specs[] = {make_tree_spec<Policy<RTP_MIN_BASE + I>>()...};
+    return specs;
+}
+
+// Composite function to grow the trees of several bases on one work-stealing pool. Tasks are single
+// nodes tagged with their job, so a large tree is spread over every worker instead of becoming a
+// straggler. Each job counts its nodes still queued or running; the worker that retires the last
+// one merges the per-thread counters and reports the base
+template <template <unsigned> class Policy>
+static void sweep_truncation_trees(RtpPolicy policy, int first_base, int last_base, int threads,
+                                   const RtpSweepCallback &on_result)
+{
+    typedef typename Policy<10>::word word;
+    const TreeSpec<word> *specs = tree_specs<Policy>(std::make_index_sequence<RTP_MAX_BASE - RTP_MIN_BASE + 1>());
+
+    struct SweepJob
+    {
+        const TreeSpec<word> *spec;
+        int base;
+        std::atomic<uint64_t> pending;
+    };
+
+    struct TreeNode
+    {
+        word value;
+        int depth;
+        int job;
+    };
+
+    int job_count = last_base - first_base + 1;
+    std::unique_ptr<SweepJob[]> jobs(new SweepJob[job_count]);
+    WorkStealingPool<TreeNode> pool(threads);
+    std::mutex report_mutex;
+
+    // per_thread[worker][job] holds that worker's per-digit counts for the job
+    std::vector<std::vector<std::vector<uint64_t>>> per_thread(pool.threads(), std::vector<std::vector<uint64_t>>(job_count));
+
+    auto report = [&](int job) {
+        RtpResult result;
+        result.status = RTP_OK;
+        result.digits = jobs[job].spec->max_digits;
+        result.policy = policy;
+        result.base = jobs[job].base;
+        result.has_prime_counts = false;
+        result.depth = result.digits; // Trees run to exhaustion, so every level is computed
+        result.right_trunc_per_digit.assign(result.digits + 1, 0);
+        for (const std::vector<std::vector<uint64_t>> &counts : per_thread)
+        {
+            for (int i = 1; i <= result.digits; ++i)
+            {
+                result.right_trunc_per_digit[i] += counts[job][i];
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(report_mutex);
+        on_result(result);
+    };
+
+    // Seeds go in ascending base order: owners pop their newest task first, so every worker
+    // starts on the largest (slowest) base it was dealt, while thieves take the small ones
+    std::vector<TreeNode> seeds;
+    for (int job = 0; job < job_count; ++job)
+    {
+        jobs[job].spec = &specs[first_base + job - RTP_MIN_BASE];
+        jobs[job].base = first_base + job;
+        jobs[job].pending.store(jobs[job].spec->root_count, std::memory_order_relaxed);
+        for (std::vector<std::vector<uint64_t>> &counts : per_thread)
+        {
+            counts[job].assign(jobs[job].spec->max_digits + 1, 0);
+        }
+        for (int i = 0; i < jobs[job].spec->root_count; ++i)
+        {
+            seeds.push_back(TreeNode{jobs[job].spec->roots[i], 1, job});
+        }
+    }
+
+    // Bases without one-digit primes (base 2) have nothing to grow
+    for (int job = 0; job < job_count; ++job)
+    {
+        if (jobs[job].spec->root_count == 0) report(job);
+    }
+
+    pool.run(seeds, [&](const TreeNode &node, int worker) {
+        SweepJob &job = jobs[node.job];
+        const TreeSpec<word> *spec = job.spec;
+        if (spec->counted(node.value, node.depth)) per_thread[worker][node.job][node.depth]++;
+
+        if (node.depth == spec->word_digits && node.depth < spec->max_digits)
+        {
+            spec->grow_wider(node.value, node.depth, spec->max_digits, per_thread[worker][node.job]);
+        }
+        else if (node.depth < spec->max_digits)
+        {
+            word child_values[RTP_MAX_BASE];
+            int child_count = spec->children(node.value, node.depth, child_values);
+            job.pending.fetch_add(child_count, std::memory_order_relaxed);
+            for (int i = 0; i < child_count; ++i)
+            {
+                pool.push(worker, TreeNode{child_values[i], node.depth + 1, node.job});
+            }
+        }
+
+        if (job.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) report(node.job);
+    });
+}
+
+void rtp_sweep_bases(RtpPolicy policy, int first_base, int last_base, int threads, const RtpSweepCallback &on_result)
+{
+    if (first_base < RTP_MIN_BASE) first_base = RTP_MIN_BASE;
+    if (last_base > RTP_MAX_BASE) last_base = RTP_MAX_BASE;
+    if (first_base > last_base) return;
+
+    switch (policy)
+    {
+    case RTP_POLICY_RIGHT:     sweep_truncation_trees<RightPolicy>(policy, first_base, last_base, threads, on_result); break;
+    case RTP_POLICY_LEFT:      sweep_truncation_trees<LeftPolicy>(policy, first_base, last_base, threads, on_result); break;
+    case RTP_POLICY_TWO_SIDED: sweep_truncation_trees<TwoSidedPolicy>(policy, first_base, last_base, threads, on_result); break;
+    }
+}
+
+const char *rtp_policy_name(RtpPolicy policy)
+{
+    switch (policy)
+    {
+    case RTP_POLICY_RIGHT:     return "right";
+    case RTP_POLICY_LEFT:      return "left";
+    case RTP_POLICY_TWO_SIDED: return "two-sided";
+    }
+    return "unknown";
+}
+
+bool rtp_parse_policy(const char *name, RtpPolicy *policy)
+{
+    static const RtpPolicy policies[] = {RTP_POLICY_RIGHT, RTP_POLICY_LEFT, RTP_POLICY_TWO_SIDED};
+    for (RtpPolicy candidate : policies)
+    {
+        if (strcmp(name, rtp_policy_name(candidate)) == 0)
+        {
+            *policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper function to find the tree spec a range grows (NULL for an unsupported base)
+static const TreeSpec<rtp_u128> *range_tree_spec(RtpPolicy policy, int base)
+{
+    if (base < RTP_MIN_BASE || base > RTP_MAX_BASE) return NULL;
+    std::make_index_sequence<RTP_MAX_BASE - RTP_MIN_BASE + 1> bases;
+    switch (policy)
+    {
+    case RTP_POLICY_RIGHT: return &tree_specs<RightPolicy>(bases)[base - RTP_MIN_BASE];
+    case RTP_POLICY_LEFT: return &tree_specs<LeftPolicy>(bases)[base - RTP_MIN_BASE];
+    case RTP_POLICY_TWO_SIDED: return &tree_specs<TwoSidedPolicy>(bases)[base - RTP_MIN_BASE];
+    }
+    return NULL;
+}
+
+RtpRange::iterator::iterator(int max_digits, RtpPolicy policy, int base)
+    : policy_(policy), base_(base), max_digits_(max_digits), level_(0), index_(0), done_(false), current_{0, 0}
+{
+    const TreeSpec<rtp_u128> *spec = range_tree_spec(policy_, base_);
+    if (!spec || max_digits_ < 1)
+    {
+        done_ = true;
+        return;
+    }
+    if (max_digits_ > spec->word_digits) max_digits_ = spec->word_digits;
+    advance();
+}
+
+void RtpRange::iterator::advance()
+{
+    const TreeSpec<rtp_u128> *spec = range_tree_spec(policy_, base_);
+    while (!done_)
+    {
+        if (index_ < frontier_.size())
+        {
+            rtp_u128 value = frontier_[index_++];
+            if (!spec->counted(value, level_)) continue; // Two-sided: a right-tree node with a composite suffix
+            current_ = RtpPrime{value, level_};
+            return;
+        }
+
+        // Grow the next level from the whole frontier, unless the last level was reached or empty
+        if (level_ == max_digits_ || (level_ > 0 && frontier_.empty()))
+        {
+            done_ = true;
+            return;
+        }
+        std::vector<rtp_u128> next;
+        if (level_ == 0)
+        {
+            next.assign(spec->roots, spec->roots + spec->root_count);
+        }
+        else
+        {
+            rtp_u128 children[RTP_MAX_BASE];
+            for (rtp_u128 value : frontier_)
+            {
+                int child_count = spec->children(value, level_, children);
+                next.insert(next.end(), children, children + child_count);
+            }
+        }
+        // Appended digits keep a sorted level sorted, prepended ones (left policy) do not
+        if (!std::is_sorted(next.begin(), next.end())) std::sort(next.begin(), next.end());
+
+        frontier_.swap(next);
+        level_++;
+        index_ = 0;
+    }
+}
+
+RtpIndex::RtpIndex() : RtpIndex(kRtpBase10Table.values, kRtpBase10Table.count) {}
+
+RtpIndex::RtpIndex(const unsigned long long *sorted, size_t count) : tree_(count + 1, 0)
+{
+    size_t next = 0;
+    fill(sorted, next, 1);
+}
+
+// In-order walk of the implicit tree hands out the sorted values in order
+void RtpIndex::fill(const unsigned long long *sorted, size_t &next, size_t k)
+{
+    if (k >= tree_.size()) return;
+    fill(sorted, next, 2 * k);
+    tree_[k] = sorted[next++];
+    fill(sorted, next, 2 * k + 1);
+}
+
+int RtpIndex::prefix_depth(unsigned long long n) const
+{
+    if (n == 0) return 0;
+
+    int length = 1;
+    while (length < 20 && n >= power_of_10(length)) length++;
+
+    // Every prefix of a right-truncatable prime is one too, so stop at the first miss
+    for (int k = 1; k <= length; ++k)
+    {
+        if (!contains(n / power_of_10(length - k))) return k - 1;
+    }
+    return length;
+}
+
+bool rtp_is_right_truncatable(unsigned long long n)
+{
+    static const RtpIndex index;
+    return index.contains(n);
+}
+
+int rtp_prime_prefix_depth(unsigned long long n)
+{
+    static const RtpIndex index;
+    return index.prefix_depth(n);
+}
+
+const char *rtp_status_message(RtpStatus status)
+{
+    switch (status)
+    {
+    case RTP_OK:                 return "ok";
+    case RTP_INVALID_DIGITS:     return "digits out of range (19 for the sieve engines, 154 for the base-10 right tree)";
+    case RTP_SIEVE_FAILED:       return "error generating primes";
+    case RTP_UNSUPPORTED_POLICY: return "left and two-sided truncation need the tree engine";
+    case RTP_UNSUPPORTED_BASE:   return "bases other than 10 need the tree engine (bases 2 to 36)";
+    }
+    return "unknown status";
+}
+
+const char *rtp_engine_name(RtpEngine engine)
+{
+    switch (engine)
+    {
+    case RTP_ENGINE_SIEVE:  return "sieve";
+    case RTP_ENGINE_MEMO:   return "memo";
+    case RTP_ENGINE_STREAM: return "stream";
+    case RTP_ENGINE_TREE:   return "tree";
+    case RTP_ENGINE_TABLE:  return "table";
+    }
+    return "unknown";
+}
+
+bool rtp_parse_engine(const char *name, RtpEngine *engine)
+{
+    static const RtpEngine engines[] = {RTP_ENGINE_SIEVE, RTP_ENGINE_MEMO, RTP_ENGINE_STREAM, RTP_ENGINE_TREE, RTP_ENGINE_TABLE};
+    for (RtpEngine candidate : engines)
+    {
+        if (strcmp(name, rtp_engine_name(candidate)) == 0)
+        {
+            *engine = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t RtpResult::total_right_trunc() const
+{
+    uint64_t total = 0;
+    for (size_t i = 1; i < right_trunc_per_digit.size(); ++i)
+    {
+        total += right_trunc_per_digit[i];
+    }
+    return total;
+}
+
+uint64_t RtpResult::total_primes() const
+{
+    uint64_t total = 0;
+    for (size_t i = 1; i < primes_per_digit.size(); ++i)
+    {
+        total += primes_per_digit[i];
+    }
+    return total;
+}
+
+// Utility function to read the current resident set size in KiB. The process-wide peak would be
+// the same for every stage once the largest sieve has run, so stages sample the current size
+static long resident_set_kb()
+{
+#ifdef __linux__
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (!statm) return -1;
+    long pages_total = 0, pages_resident = -1;
+    if (fscanf(statm, "%ld %ld", &pages_total, &pages_resident) != 2) pages_resident = -1;
+    fclose(statm);
+    return pages_resident < 0 ? -1 : pages_resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Peak only, reported in bytes on macOS
+#else
+    return usage.ru_maxrss;        // Peak only, in KiB
+#endif
+#endif
+}
+
+// Adds the wall and CPU time of its own lifetime to one stage of a count, and keeps the largest
+// resident set size seen when it ends
+class StageTimer
+{
+public:
+    explicit StageTimer(RtpStageStats &stats)
+        : stats_(stats), wall_start_(std::chrono::steady_clock::now()), cpu_start_(std::clock()) {}
+
+    ~StageTimer()
+    {
+        std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - wall_start_;
+        stats_.wall_ms += wall.count();
+        stats_.cpu_ms += (double)(std::clock() - cpu_start_) * 1000 / CLOCKS_PER_SEC;
+        long rss_kb = resident_set_kb();
+        if (rss_kb > stats_.peak_rss_kb) stats_.peak_rss_kb = rss_kb;
+    }
+
+private:
+    RtpStageStats &stats_;
+    std::chrono::steady_clock::time_point wall_start_;
+    std::clock_t cpu_start_;
+};
+
+RtpContext::RtpContext(int threads) : threads_(threads < 1 ? 1 : threads), prime_digits_(0), bitmap_digits_(0) {}
+
+RtpStatus RtpContext::prepare_primes(int digits)
+{
+    if (digits < 1 || digits > RTP_MAX_SIEVE_DIGITS) return RTP_INVALID_DIGITS;
+    if (digits <= prime_digits_) return RTP_OK;
+
+    // Release the old buffer first so two sieves are never resident together
+    primes_.reset();
+    digit_offsets_.clear();
+    prime_digits_ = 0;
+
+    std::unique_ptr<PrimeBuffer> primes(new PrimeBuffer(2, power_of_10(digits) - 1));
+    if (!primes->ok()) return RTP_SIEVE_FAILED;
+
+    primes_ = std::move(primes);
+    digit_offsets_ = find_digit_windows(primes_->span(), digits);
+    prime_digits_ = digits;
+    return RTP_OK;
+}
+
+RtpStatus RtpContext::prepare_bitmap(int digits)
+{
+    RtpStatus status = prepare_primes(digits);
+    if (status != RTP_OK) return status;
+    if (digits <= bitmap_digits_) return RTP_OK;
+
+    // Grow the existing bitmap and only mark the primes it does not cover yet
+    if (prime_bitset_) prime_bitset_->extend(power_of_10(digits) - 1);
+    else prime_bitset_.reset(new Wheel30Bitset(power_of_10(digits) - 1));
+
+    PrimeSpan all_primes_array = primes();
+    for (size_t i = digit_offsets_[bitmap_digits_]; i < digit_offsets_[digits]; ++i)
+    {
+        prime_bitset_->set(all_primes_array[i]);
+    }
+
+    bitmap_digits_ = digits;
+    return RTP_OK;
+}
+
+RtpStatus RtpContext::prepare_primes_timed(int digits, RtpStageStats &stats)
+{
+    StageTimer timer(stats);
+    int old_digits = prime_digits_;
+    RtpStatus status = prepare_primes(digits);
+    if (prime_digits_ != old_digits) stats.bytes_allocated += primes().size() * sizeof(unsigned long long);
+    return status;
+}
+
+PrimeSpan RtpContext::primes() const
+{
+    return primes_ ? primes_->span() : PrimeSpan{NULL, 0};
+}
+
+RtpResult RtpContext::count(int digits, RtpEngine engine, RtpPolicy policy, int base)
+{
+    RtpResult result;
+    result.status = RTP_OK;
+    result.digits = digits;
+    result.policy = policy;
+    result.base = base;
+    result.has_prime_counts = engine != RTP_ENGINE_TREE && engine != RTP_ENGINE_TABLE;
+    result.depth = result.has_prime_counts ? 0 : digits;
+    if (rtp_max_digits(policy, base) == 0 || (base != 10 && engine != RTP_ENGINE_TREE))
+    {
+        result.status = RTP_UNSUPPORTED_BASE;
+        return result;
+    }
+    if (digits < 1 || digits > (engine == RTP_ENGINE_TREE ? rtp_max_digits(policy, base) : RTP_MAX_SIEVE_DIGITS))
+    {
+        result.status = RTP_INVALID_DIGITS;
+        return result;
+    }
+    if (policy != RTP_POLICY_RIGHT && engine != RTP_ENGINE_TREE)
+    {
+        result.status = RTP_UNSUPPORTED_POLICY;
+        return result;
+    }
+    result.right_trunc_per_digit.assign(digits + 1, 0);
+    result.primes_per_digit.assign(digits + 1, 0);
+
+    switch (engine)
+    {
+    case RTP_ENGINE_TABLE:
+    {
+        // Bucket the compile-time table by digit length (it never exceeds 8 digits)
+        int length = 1;
+        for (int i = 0; i < kRtpBase10Table.count; ++i)
+        {
+            while (kRtpBase10Table.values[i] >= power_of_10(length)) length++;
+            if (length > digits) break;
+            result.right_trunc_per_digit[length]++;
+        }
+        break;
+    }
+
+    case RTP_ENGINE_TREE:
+        // Sieve-free path: grow the truncation tree and test each child for primality
+        count_truncatable_primes_tree(policy, result.right_trunc_per_digit, digits, threads_, base);
+        break;
+
+    case RTP_ENGINE_STREAM:
+    {
+        // Streaming path: consume primes segment by segment with constant memory for the prime list
+        Wheel30Bitset right_trunc_bitset(0);
+        count_right_trunc_primes_stream(result.primes_per_digit, result.right_trunc_per_digit, right_trunc_bitset, digits);
+
+        // Every band the stream reached holds primes, so the last one with a count is the depth
+        while (result.depth < digits && result.primes_per_digit[result.depth + 1] > 0) result.depth++;
+        break;
+    }
+
+    case RTP_ENGINE_MEMO:
+    {
+        // Record right-truncatability in its own bitmap, growing one digit length at a time. The
+        // sieve only grows with the levels, so a level without right-truncatable primes ends the
+        // count before any longer prime is generated
+        Wheel30Bitset right_trunc_bitset(0);
+        for (int i = 1; i <= digits; i++)
+        {
+            result.status = prepare_primes_timed(i, result.generate_stats);
+            if (result.status != RTP_OK) break;
+
+            StageTimer timer(result.count_stats);
+            if (i < digits)
+            {
+                right_trunc_bitset.extend(power_of_10(i) - 1);
+                result.count_stats.bytes_allocated += right_trunc_bitset.size_bytes();
+            }
+            result.right_trunc_per_digit[i] = count_right_trunc_primes_memo(primes(), digit_offsets_, result.primes_per_digit, right_trunc_bitset, i);
+            result.depth = i;
+            if (result.right_trunc_per_digit[i] == 0) break;
+        }
+        break;
+    }
+
+    case RTP_ENGINE_SIEVE:
+        // Sieve and count one digit length at a time, stopping at the first empty level
+        for (int i = 1; i <= digits; i++)
+        {
+            result.status = prepare_primes_timed(i, result.generate_stats);
+            if (result.status != RTP_OK) break;
+            {
+                StageTimer timer(result.bitmap_stats);
+                size_t old_bytes = prime_bitset_ ? prime_bitset_->size_bytes() : 0;
+                result.status = prepare_bitmap(i);
+                // Growing the bitmap reallocates it whole
+                if (prime_bitset_ && prime_bitset_->size_bytes() != old_bytes) result.bitmap_stats.bytes_allocated += prime_bitset_->size_bytes();
+            }
+            if (result.status != RTP_OK) break;
+
+            StageTimer timer(result.count_stats);
+            if (threads_ > 1)
+            {
+                // Count the band on contiguous chunks of its primes
+                count_bands_parallel(primes(), digit_offsets_, result.primes_per_digit,
+                                     result.right_trunc_per_digit, *prime_bitset_, i, i, threads_);
+            }
+            else
+            {
+                result.right_trunc_per_digit[i] = count_right_trunc_primes(primes(), digit_offsets_, result.primes_per_digit, *prime_bitset_, i);
+            }
+            result.depth = i;
+            if (result.right_trunc_per_digit[i] == 0) break;
+        }
+        break;
+    }
+
+    return result;
+}
@@ -0,0 +1,639 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+// librtp: right-truncatable prime engines with no I/O, shared by the CLI and the benchmarks
+#ifndef RTP_H
+#define RTP_H
+
+#include <stdint.h>     // For uint64_t
+#include <stddef.h>     // For size_t
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <iterator>
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#include <exception>
+#define RTP_HAS_COROUTINES 1
+#endif
+
+// Utility function to calculate power of 10
+unsigned long long power_of_10(int exp);
+
+// Utility function to test a single number for primality (deterministic for all 64-bit values)
+bool is_prime(unsigned long long n);
+
+// 128-bit values for trees that outgrow 64 bits (e.g. left-truncatable primes reach 24 digits)
+typedef unsigned __int128 rtp_u128;
+
+// Utility function to test a 128-bit number for primality (64-bit values use is_prime)
+bool is_prime_u128(rtp_u128 n);
+
+// Utility function to test a number of up to 8 64-bit limbs (least significant first) for
+// primality, as the right trees do past 128 bits: wider values get a 12-base Miller-Rabin
+// (a probable-prime test). Returns false when count is outside 1..8
+bool is_probable_prime_limbs(const uint64_t *limbs, int count);
+
+// Prime membership bitmap that only stores residues coprime to 30 (8 bits per 30 integers,
+// 3.75x smaller than one bit per integer). 2, 3 and 5 are always members
+class Wheel30Bitset
+{
+public:
+    explicit Wheel30Bitset(unsigned long long limit) : limit_(limit), bytes_(limit / 30 + 1, 0) {}
+
+    // Largest n that can be stored or tested
+    unsigned long long limit() const { return limit_; }
+
+    // Bytes held by the bitmap
+    size_t size_bytes() const { return bytes_.size(); }
+
+    // Raise limit() (never lowers it), keeping every member already set
+    void extend(unsigned long long limit)
+    {
+        if (limit <= limit_) return;
+        limit_ = limit;
+        bytes_.resize(limit / 30 + 1, 0);
+    }
+
+    // Mark n as a member (multiples of 2, 3 and 5 are ignored)
+    void set(unsigned long long n) { bytes_[n / 30] |= residue_mask[n % 30]; }
+
+    // Branch-free membership test for n <= limit()
+    bool test(unsigned long long n) const
+    {
+        return ((bytes_[n / 30] & residue_mask[n % 30]) | ((0x2Cu >> (n & 7)) & (n < 6))) != 0;
+    }
+
+private:
+    // Bit assigned to each residue mod 30 (zero for residues sharing a factor with 30)
+    static constexpr uint8_t residue_mask[30] = {
+        0, 1 << 0, 0, 0, 0, 0, 0, 1 << 1, 0, 0, 0, 1 << 2, 0, 1 << 3, 0,
+        0, 0, 1 << 4, 0, 1 << 5, 0, 0, 0, 1 << 6, 0, 0, 0, 0, 0, 1 << 7};
+
+    unsigned long long limit_;
+    std::vector<uint8_t> bytes_;
+};
+
+// Non-owning view over a contiguous, sorted array of primes
+struct PrimeSpan
+{
+    const unsigned long long *data;
+    size_t count;
+
+    size_t size() const { return count; }
+    const unsigned long long *begin() const { return data; }
+    const unsigned long long *end() const { return data + count; }
+    unsigned long long operator[](size_t i) const { return data[i]; }
+};
+
+// Owns the buffer returned by primesieve_generate_primes and releases it with primesieve_free,
+// so the primes are used in place instead of being copied into a std::vector
+class PrimeBuffer
+{
+public:
+    PrimeBuffer(unsigned long long start, unsigned long long stop);
+    ~PrimeBuffer();
+
+    PrimeBuffer(const PrimeBuffer &) = delete;
+    PrimeBuffer &operator=(const PrimeBuffer &) = delete;
+
+    // False when primesieve failed to generate the primes
+    bool ok() const { return data_ != NULL; }
+    size_t size() const { return count_; }
+    PrimeSpan span() const { return PrimeSpan{data_, count_}; }
+
+private:
+    unsigned long long *data_;
+    size_t count_;
+};
+
+// Work-stealing scheduler: every worker pops tasks LIFO from its own deque (depth first, cache
+// friendly) and, when it runs dry, steals FIFO from the others (the oldest, largest subtrees)
+template <typename Task>
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int threads) : queues_(threads < 1 ? 1 : threads), pending_(0) {}
+
+    int threads() const { return (int)queues_.size(); }
+
+    // Queue a task spawned by the given worker
+    void push(int worker, const Task &task)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+        queues_[worker].tasks.push_back(task);
+    }
+
+    // Run fn(task, worker) for every seed and every task pushed while running, returns when none remain
+    template <typename Fn>
+    void run(const std::vector<Task> &seeds, Fn fn)
+    {
+        for (size_t i = 0; i < seeds.size(); ++i)
+        {
+            push((int)(i % queues_.size()), seeds[i]);
+        }
+
+        std::vector<std::thread> workers;
+        for (int w = 0; w < threads(); ++w)
+        {
+            workers.emplace_back([this, w, &fn]() {
+                Task task;
+                while (pending_.load(std::memory_order_acquire) > 0)
+                {
+                    if (!pop(w, task) && !steal(w, task))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    fn(task, w);
+                    pending_.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            });
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool pop(int worker, Task &task)
+    {
+        std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+        if (queues_[worker].tasks.empty()) return false;
+        task = queues_[worker].tasks.back();
+        queues_[worker].tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int thief, Task &task)
+    {
+        for (int i = 1; i < threads(); ++i)
+        {
+            Queue &victim = queues_[(thief + i) % threads()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty()) continue;
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues_;
+    std::atomic<uint64_t> pending_; // Tasks queued or running
+};
+
+// Longest digit count the sieve engines cover (every prime below 10^digits fits in 64 bits)
+constexpr int RTP_MAX_SIEVE_DIGITS = 19;
+
+// Low-level engines (return -1 when digits is outside 1..RTP_MAX_SIEVE_DIGITS, or 1..154 for the trees)
+std::vector<size_t> find_digit_windows(PrimeSpan all_primes_array, int digits);
+
+int count_right_trunc_primes(PrimeSpan all_primes_array,
+                             const std::vector<size_t> &digit_offsets,
+                             std::vector<uint64_t> &primes_per_digit,
+                             const Wheel30Bitset &prime_bitset, int digits);
+
+int count_right_trunc_primes_parallel(PrimeSpan all_primes_array,
+                                      const std::vector<size_t> &digit_offsets,
+                                      std::vector<uint64_t> &primes_per_digit,
+                                      std::vector<uint64_t> &right_trunc_per_digit,
+                                      const Wheel30Bitset &prime_bitset, int digits, int threads);
+
+int count_right_trunc_primes_memo(PrimeSpan all_primes_array,
+                                  const std::vector<size_t> &digit_offsets,
+                                  std::vector<uint64_t> &primes_per_digit,
+                                  Wheel30Bitset &right_trunc_bitset, int digits);
+
+int count_right_trunc_primes_stream(std::vector<uint64_t> &primes_per_digit,
+                                    std::vector<uint64_t> &right_trunc_per_digit,
+                                    Wheel30Bitset &right_trunc_bitset, int digits);
+
+int count_right_trunc_primes_tree(std::vector<uint64_t> &right_trunc_per_digit, int digits);
+
+int count_right_trunc_primes_tree_parallel(std::vector<uint64_t> &right_trunc_per_digit, int digits, int threads);
+
+// Compile-time Miller-Rabin (same witnesses as is_prime, plain 128-bit products instead of
+// Montgomery form since constant evaluation has no hardware multiplier to exploit)
+constexpr unsigned long long rtp_constexpr_pow_mod(unsigned long long a, unsigned long long e, unsigned long long n)
+{
+    unsigned long long result = 1;
+    a %= n;
+    for (; e > 0; e >>= 1)
+    {
+        if (e & 1) result = (unsigned long long)((unsigned __int128)result * a % n);
+        a = (unsigned long long)((unsigned __int128)a * a % n);
+    }
+    return result;
+}
+
+constexpr bool rtp_constexpr_is_prime(unsigned long long n)
+{
+    const unsigned long long small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if (n < 2) return false;
+    for (unsigned long long p : small_primes)
+    {
+        if (n % p == 0) return n == p;
+    }
+    if (n < 37 * 37) return true;
+
+    unsigned long long d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
+
+    const unsigned long long witnesses[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (unsigned long long a : witnesses)
+    {
+        if (a % n == 0) continue;
+        unsigned long long x = rtp_constexpr_pow_mod(a, d, n);
+        if (x == 1 || x == n - 1) continue;
+
+        bool composite = true;
+        for (int r = 1; r < s && composite; ++r)
+        {
+            x = (unsigned long long)((unsigned __int128)x * x % n);
+            if (x == n - 1) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// The complete base-10 right-truncatable table, in ascending order
+struct RtpTable
+{
+    unsigned long long values[128];
+    int count;
+};
+
+// Grows the base-10 tree level by level at compile time (sorted parents give sorted children)
+constexpr RtpTable rtp_build_base10_table()
+{
+    RtpTable table{};
+    const int last_digits[] = {1, 3, 7, 9};
+    const unsigned long long roots[] = {2, 3, 5, 7};
+    for (unsigned long long root : roots)
+    {
+        table.values[table.count++] = root;
+    }
+
+    int level_first = 0;
+    while (level_first < table.count)
+    {
+        int level_last = table.count;
+        for (int i = level_first; i < level_last; ++i)
+        {
+            for (int d : last_digits)
+            {
+                unsigned long long child = table.values[i] * 10 + d;
+                if (rtp_constexpr_is_prime(child)) table.values[table.count++] = child;
+            }
+        }
+        level_first = level_last;
+    }
+    return table;
+}
+
+inline constexpr RtpTable kRtpBase10Table = rtp_build_base10_table();
+
+static_assert(kRtpBase10Table.count == 83, "base 10 has 83 right-truncatable primes");
+static_assert(kRtpBase10Table.values[82] == 73939133, "the largest is 73939133");
+
+// Which truncations must stay prime
+enum RtpPolicy
+{
+    RTP_POLICY_RIGHT,    // Remove digits from the right (the default)
+    RTP_POLICY_LEFT,     // Remove digits from the left, no zero digits
+    RTP_POLICY_TWO_SIDED // Both of the above
+};
+
+const char *rtp_policy_name(RtpPolicy policy);
+
+// Parse "right", "left" or "two-sided", returns false for anything else
+bool rtp_parse_policy(const char *name, RtpPolicy *policy);
+
+// Bases with a prebuilt tree engine specialization
+constexpr int RTP_MIN_BASE = 2;
+constexpr int RTP_MAX_BASE = 36;
+
+// One truncatable prime and its digit length
+struct RtpPrime
+{
+    rtp_u128 value;
+    int digits;
+};
+
+// Lazily yields every prime of a policy's tree in a base with at most max_digits digits, in
+// ascending order. The tree is grown one level at a time from a single frontier (the current
+// level, sorted), so each node is tested once; iteration ends early once a level is empty. Values
+// are 128-bit, so right-truncatable trees that outgrow 128 bits (bases 34 to 36) stop at the
+// deepest level that fits, and max_digits < 1 or an unsupported base gives an empty range
+class RtpRange
+{
+public:
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef RtpPrime value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const RtpPrime *pointer;
+        typedef const RtpPrime &reference;
+
+        iterator()
+            : policy_(RTP_POLICY_RIGHT), base_(10), max_digits_(0), level_(0), index_(0), done_(true), current_{0, 0} {}
+        iterator(int max_digits, RtpPolicy policy, int base);
+
+        const RtpPrime &operator*() const { return current_; }
+        const RtpPrime *operator->() const { return &current_; }
+        iterator &operator++()
+        {
+            advance();
+            return *this;
+        }
+        bool operator==(const iterator &other) const
+        {
+            return done_ == other.done_ && (done_ || current_.value == other.current_.value);
+        }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        void advance();
+
+        RtpPolicy policy_;
+        int base_;
+        int max_digits_;
+        int level_;                      // Digit length of the frontier
+        size_t index_;                   // Next frontier node to yield
+        bool done_;
+        RtpPrime current_;
+        std::vector<rtp_u128> frontier_; // Every tree node of length level_, ascending
+    };
+
+    explicit RtpRange(int max_digits, RtpPolicy policy = RTP_POLICY_RIGHT, int base = 10)
+        : max_digits_(max_digits), policy_(policy), base_(base) {}
+
+    iterator begin() const { return iterator(max_digits_, policy_, base_); }
+    iterator end() const { return iterator(); }
+
+private:
+    int max_digits_;
+    RtpPolicy policy_;
+    int base_;
+};
+
+#ifdef RTP_HAS_COROUTINES
+// Minimal C++20 generator: values are produced on demand by a suspended coroutine
+template <typename T>
+class RtpGenerator
+{
+public:
+    struct promise_type
+    {
+        const T *value;
+
+        RtpGenerator get_return_object() { return RtpGenerator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T &v) noexcept
+        {
+            value = &v;
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    class iterator
+    {
+    public:
+        explicit iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+        const T &operator*() const { return *handle_.promise().value; }
+        iterator &operator++()
+        {
+            handle_.resume();
+            return *this;
+        }
+        bool operator!=(std::default_sentinel_t) const { return !handle_.done(); }
+        bool operator==(std::default_sentinel_t) const { return handle_.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    explicit RtpGenerator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    RtpGenerator(RtpGenerator &&other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    RtpGenerator(const RtpGenerator &) = delete;
+    RtpGenerator &operator=(const RtpGenerator &) = delete;
+    ~RtpGenerator()
+    {
+        if (handle_) handle_.destroy();
+    }
+
+    iterator begin()
+    {
+        handle_.resume();
+        return iterator(handle_);
+    }
+    std::default_sentinel_t end() { return std::default_sentinel; }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Coroutine variant of RtpRange
+inline RtpGenerator<RtpPrime> rtp_generate(int max_digits, RtpPolicy policy = RTP_POLICY_RIGHT, int base = 10)
+{
+    for (const RtpPrime &prime : RtpRange(max_digits, policy, base))
+    {
+        co_yield prime;
+    }
+}
+#endif // RTP_HAS_COROUTINES
+
+// Membership index over a sorted set of right-truncatable primes, stored in Eytzinger order
+// (the breadth-first layout of an implicit binary search tree) so each lookup walks one
+// cache-friendly, branch-free path
+class RtpIndex
+{
+public:
+    // Index the base-10 table
+    RtpIndex();
+
+    // Index any sorted set (e.g. collected from an RtpRange)
+    RtpIndex(const unsigned long long *sorted, size_t count);
+
+    size_t size() const { return tree_.size() - 1; }
+
+    bool contains(unsigned long long n) const
+    {
+        size_t count = tree_.size() - 1;
+        size_t k = 1;
+        while (k <= count)
+        {
+            k = 2 * k + (tree_[k] < n);
+        }
+        k >>= __builtin_ffsll((long long)~k); // Undo the right turns taken after the last left turn
+        return k != 0 && tree_[k] == n;
+    }
+
+    // Digit length of the longest right-truncatable prefix of n (0 when even its leading digit is not)
+    int prefix_depth(unsigned long long n) const;
+
+private:
+    void fill(const unsigned long long *sorted, size_t &next, size_t k);
+
+    std::vector<unsigned long long> tree_; // 1-based, tree_[0] unused
+};
+
+// Base-10 queries backed by a shared RtpIndex over kRtpBase10Table
+bool rtp_is_right_truncatable(unsigned long long n);
+int rtp_prime_prefix_depth(unsigned long long n);
+
+// Largest digit count a policy's tree supports in a base: 38 in base 10 for the 128-bit left and
+// two-sided trees, 154 for the right tree (512-bit BigUInt), 0 when the base is outside
+// RTP_MIN_BASE..RTP_MAX_BASE
+int rtp_max_digits(RtpPolicy policy, int base = 10);
+
+// Count a policy's primes per digit length in a base with the shared tree expander (threads > 1
+// uses the work-stealing pool), returns -1 when digits is outside 1..rtp_max_digits(policy, base)
+int count_truncatable_primes_tree(RtpPolicy policy, std::vector<uint64_t> &per_digit, int digits, int threads, int base = 10);
+
+// Outcome of a library call
+enum RtpStatus
+{
+    RTP_OK = 0,
+    RTP_INVALID_DIGITS,     // digits outside 1..rtp_max_digits(policy, base)
+    RTP_SIEVE_FAILED,       // primesieve could not generate the primes
+    RTP_UNSUPPORTED_POLICY, // Only the tree engine handles left and two-sided truncation
+    RTP_UNSUPPORTED_BASE    // Base outside RTP_MIN_BASE..RTP_MAX_BASE, or not 10 for a non-tree engine
+};
+
+// Counting engines (see README for the trade-offs)
+enum RtpEngine
+{
+    RTP_ENGINE_SIEVE,
+    RTP_ENGINE_MEMO,
+    RTP_ENGINE_STREAM,
+    RTP_ENGINE_TREE,
+    RTP_ENGINE_TABLE    // Reads kRtpBase10Table, no computation at run time
+};
+
+const char *rtp_status_message(RtpStatus status);
+const char *rtp_engine_name(RtpEngine engine);
+
+// Parse "sieve", "memo", "stream", "tree" or "table", returns false for anything else
+bool rtp_parse_engine(const char *name, RtpEngine *engine);
+
+// Longest digit count rtp_count_primes_per_digit handles in a base: every number of that length
+// fits in 64 bits (19 in base 10) and the pi(x) tables fit in half of physical memory (18 in
+// base 10 needs 24 GB of RAM, 17 about 8 GB). 0 when the base is outside RTP_MIN_BASE..RTP_MAX_BASE
+int rtp_max_prime_count_digits(int base = 10);
+
+// Count the primes up to x with the Lucy-Hedgehog recurrence in O(x^(3/4) / log x) time and
+// O(x^(1/2)) memory (threads > 1 splits each sieving step across a team of threads)
+uint64_t rtp_prime_pi(uint64_t x, int threads = 1);
+
+// Count the primes of digit lengths first..last in a base, bands [base^(k-1), base^k). One
+// Lucy-Hedgehog run at base^last - 1 yields every band, and no prime array is ever built. Returns
+// RTP_INVALID_DIGITS when last exceeds rtp_max_prime_count_digits(base). Fills
+// primes_per_digit[first..last] (growing the vector when needed) and leaves other entries alone
+RtpStatus rtp_count_primes_per_digit(std::vector<uint64_t> &primes_per_digit, int first, int last, int base = 10,
+                                     int threads = 1);
+
+// Wall time, CPU time and bytes allocated by one stage of a count, summed over every level, and
+// the largest resident set size the stage left at the end of a level (0 when unavailable)
+struct RtpStageStats
+{
+    double wall_ms;
+    double cpu_ms;
+    long peak_rss_kb;
+    uint64_t bytes_allocated;
+};
+
+// Per-digit results of one count, indexed by digit length (index 0 is unused)
+struct RtpResult
+{
+    RtpStatus status = RTP_OK;
+    int digits = 0;
+    RtpPolicy policy = RTP_POLICY_RIGHT;       // Family counted in right_trunc_per_digit
+    int base = 10;                             // Radix the digits are counted in
+    bool has_prime_counts = false;             // primes_per_digit is valid for levels 1..depth (false for
+                                               // the tree and table engines, which never sieve)
+    int depth = 0;                             // Levels actually computed: the sieve engines stop after the
+                                               // first level without right-truncatable primes, and every
+                                               // level above it is reported as zero without being sieved
+                                               // (its prime count is 0 too, not the real count)
+    std::vector<uint64_t> right_trunc_per_digit;
+    std::vector<uint64_t> primes_per_digit;
+
+    // Stages of the sieve and memo engines, which sieve again at every level (all zero otherwise)
+    RtpStageStats generate_stats = {}; // prepare_primes: every prime buffer generated
+    RtpStageStats bitmap_stats = {};   // prepare_bitmap: growth of the prime bitmap (sieve engine only)
+    RtpStageStats count_stats = {};    // Truncation checks, including the memo bitmap
+
+    uint64_t total_right_trunc() const;
+    uint64_t total_primes() const;
+};
+
+// Receives one finished base of a sweep (calls are serialized, but come from pool threads)
+typedef std::function<void(const RtpResult &result)> RtpSweepCallback;
+
+// Count a policy's primes in every base from first_base to last_base (clamped to
+// RTP_MIN_BASE..RTP_MAX_BASE), each up to rtp_max_digits(policy, base). All trees share one
+// work-stealing pool of threads, and on_result gets each base as soon as its tree is exhausted
+void rtp_sweep_bases(RtpPolicy policy, int first_base, int last_base, int threads, const RtpSweepCallback &on_result);
+
+// Owns the prime source and prime bitmap so repeated counts reuse them: sieving and the
+// bitmap build only happen when a call needs more digits than any earlier one
+class RtpContext
+{
+public:
+    explicit RtpContext(int threads = 1);
+
+    int threads() const { return threads_; }
+
+    // Sieve every prime below 10^digits (no-op when already covered)
+    RtpStatus prepare_primes(int digits);
+
+    // Build the prime membership bitmap used by the sieve engine (no-op when already covered; a
+    // smaller bitmap from an earlier call is extended rather than rebuilt)
+    RtpStatus prepare_bitmap(int digits);
+
+    // Primes sieved so far (empty before prepare_primes)
+    PrimeSpan primes() const;
+
+    // Count right-truncatable primes (and primes, except for the tree and table engines) per digit
+    // length, or left/two-sided truncatable primes and other bases with the tree engine
+    RtpResult count(int digits, RtpEngine engine, RtpPolicy policy = RTP_POLICY_RIGHT, int base = 10);
+
+private:
+    // prepare_primes, adding its time and any newly sieved buffer to stats
+    RtpStatus prepare_primes_timed(int digits, RtpStageStats &stats);
+
+    int threads_;
+    int prime_digits_;                           // Digit length covered by primes_
+    std::unique_ptr<PrimeBuffer> primes_;
+    std::vector<size_t> digit_offsets_;
+    int bitmap_digits_;                          // Digit length covered by prime_bitset_
+    std::unique_ptr<Wheel30Bitset> prime_bitset_;
+};
+
+#endif // RTP_H
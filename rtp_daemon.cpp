@@ -0,0 +1,340 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+// Long-running query server: builds librtp state once and answers requests over a Unix socket
+#include "rtp_daemon.h"
+#include "rtp.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <condition_variable>
+#include <map>
+#include <utility>
+
+// Seconds a worker waits on a client that stops reading its response before dropping it
+static const int RTP_DAEMON_SEND_TIMEOUT_S = 5;
+
+// State shared by every worker: the context (sieve buffers) and cached answers to hot queries
+struct DaemonState
+{
+    std::mutex context_mutex;
+    RtpContext context;
+
+    std::mutex cache_mutex;
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<uint64_t>> count_cache; // (digits, engine)
+    std::map<uint32_t, std::vector<uint64_t>> enumerate_cache;                  // max digits
+};
+
+// A request fully read by the polling thread, waiting for a worker
+struct PendingRequest
+{
+    int fd;
+    RtpDaemonRequest request;
+};
+
+// Requests waiting for a worker, and connections handed back by the workers once their request
+// is answered (the polling thread is woken through wake_fds)
+struct ClientQueue
+{
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<PendingRequest> requests;
+    std::vector<int> returned;
+    int wake_fds[2];
+};
+
+// An idle connection and the bytes of its next request received so far
+struct PartialRequest
+{
+    char bytes[sizeof(RtpDaemonRequest)];
+    size_t filled;
+};
+
+// Helper function to write exactly size bytes, returns false on error
+static bool write_full(int fd, const void *data, size_t size)
+{
+    const char *p = (const char *)data;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+// Helper function to compute (or fetch from the cache) the payload of one request
+static uint32_t answer_request(DaemonState &state, const RtpDaemonRequest &request, std::vector<uint64_t> &payload)
+{
+    payload.clear();
+    switch (request.op)
+    {
+    case RTP_OP_QUERY:
+        payload.push_back(is_prime(request.value));
+        payload.push_back(rtp_is_right_truncatable(request.value));
+        payload.push_back((uint64_t)rtp_prime_prefix_depth(request.value));
+        return RTP_OK;
+
+    case RTP_OP_ENUMERATE:
+    {
+        if (request.arg < 1 || request.arg > 19) return RTP_INVALID_DIGITS;
+        {
+            std::lock_guard<std::mutex> lock(state.cache_mutex);
+            auto it = state.enumerate_cache.find(request.arg);
+            if (it != state.enumerate_cache.end())
+            {
+                payload = it->second;
+                return RTP_OK;
+            }
+        }
+
+        for (const RtpPrime &prime : RtpRange((int)request.arg))
+        {
+            payload.push_back((uint64_t)prime.value); // Base-10 right-truncatable primes fit 64 bits
+        }
+
+        std::lock_guard<std::mutex> lock(state.cache_mutex);
+        state.enumerate_cache[request.arg] = payload;
+        return RTP_OK;
+    }
+
+    case RTP_OP_COUNT:
+    {
+        if (request.value > RTP_ENGINE_TABLE) return RTP_DAEMON_BAD_REQUEST;
+        std::pair<uint32_t, uint32_t> key(request.arg, (uint32_t)request.value);
+        {
+            std::lock_guard<std::mutex> lock(state.cache_mutex);
+            auto it = state.count_cache.find(key);
+            if (it != state.count_cache.end())
+            {
+                payload = it->second;
+                return RTP_OK;
+            }
+        }
+
+        RtpResult result;
+        {
+            // The context reuses (and may grow) its sieve, so counts are serialized
+            std::lock_guard<std::mutex> lock(state.context_mutex);
+            result = state.context.count((int)request.arg, (RtpEngine)request.value);
+        }
+        if (result.status != RTP_OK) return result.status;
+
+        payload.push_back(result.has_prime_counts);
+        payload.push_back((uint64_t)result.depth);
+        payload.insert(payload.end(), result.right_trunc_per_digit.begin() + 1, result.right_trunc_per_digit.end());
+        payload.insert(payload.end(), result.primes_per_digit.begin() + 1, result.primes_per_digit.end());
+
+        std::lock_guard<std::mutex> lock(state.cache_mutex);
+        state.count_cache[key] = payload;
+        return RTP_OK;
+    }
+    }
+    return RTP_DAEMON_BAD_REQUEST;
+}
+
+// Helper function to answer one request, returns false once the connection failed
+static bool serve_request(DaemonState &state, int fd, const RtpDaemonRequest &request)
+{
+    std::vector<uint64_t> payload;
+    RtpDaemonResponse response;
+    response.status = answer_request(state, request, payload);
+    if (response.status != RTP_OK) payload.clear();
+    response.count = (uint32_t)payload.size();
+
+    if (!write_full(fd, &response, sizeof(response))) return false;
+    if (!payload.empty() && !write_full(fd, payload.data(), payload.size() * sizeof(uint64_t))) return false;
+    return true;
+}
+
+// Helper function to read whatever part of the next request has arrived without blocking,
+// returns false once the client has hung up or the connection failed
+static bool receive_partial(int fd, PartialRequest &partial)
+{
+    while (partial.filled < sizeof(partial.bytes))
+    {
+        ssize_t n = recv(fd, partial.bytes + partial.filled, sizeof(partial.bytes) - partial.filled, MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (n <= 0) return false;
+        partial.filled += (size_t)n;
+    }
+    return true;
+}
+
+int run_daemon(const char *socket_path, int threads)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "Error: socket path '%s' is too long.\n", socket_path);
+        return 1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    // A stale socket file from an earlier run would make bind fail
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listen_fd, 128) != 0)
+    {
+        perror("bind/listen");
+        close(listen_fd);
+        return 1;
+    }
+
+    // A connection aborted between poll and accept must not block the polling thread
+    fcntl(listen_fd, F_SETFL, O_NONBLOCK);
+
+    // Clients that hang up mid-response must not kill the daemon
+    signal(SIGPIPE, SIG_IGN);
+
+    DaemonState state;
+    ClientQueue queue;
+    if (threads < 1) threads = 1;
+    if (pipe(queue.wake_fds) != 0)
+    {
+        perror("pipe");
+        close(listen_fd);
+        return 1;
+    }
+    // Non-blocking so draining never waits and a full pipe (already a pending wake-up) never blocks a worker
+    fcntl(queue.wake_fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(queue.wake_fds[1], F_SETFL, O_NONBLOCK);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&state, &queue]() {
+            for (;;)
+            {
+                PendingRequest pending;
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    queue.ready.wait(lock, [&queue]() { return !queue.requests.empty(); });
+                    pending = queue.requests.front();
+                    queue.requests.pop_front();
+                }
+                if (!serve_request(state, pending.fd, pending.request))
+                {
+                    close(pending.fd);
+                    continue;
+                }
+
+                // Hand the connection back to the polling thread for its next request
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.returned.push_back(pending.fd);
+                }
+                char wake = 1;
+                while (write(queue.wake_fds[1], &wake, 1) < 0 && errno == EINTR) {}
+            }
+        });
+    }
+
+    // The pool serves requests, not connections: idle connections are polled here and read without
+    // blocking, and only a complete request goes to a worker, so any number of persistent (or
+    // stalled) clients share the threads
+    fprintf(stderr, "Listening on %s with %d worker thread(s).\n", socket_path, threads);
+    std::map<int, PartialRequest> idle;
+    std::vector<struct pollfd> polled;
+    for (;;)
+    {
+        polled.clear();
+        polled.push_back(pollfd{listen_fd, POLLIN, 0});
+        polled.push_back(pollfd{queue.wake_fds[0], POLLIN, 0});
+        for (const auto &connection : idle)
+        {
+            polled.push_back(pollfd{connection.first, POLLIN, 0});
+        }
+
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            perror("poll");
+            break;
+        }
+
+        // Complete requests go to the pool in arrival order; hang-ups are closed here
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (size_t i = 2; i < polled.size(); ++i)
+            {
+                if (polled[i].revents == 0) continue;
+                int fd = polled[i].fd;
+                PartialRequest &partial = idle[fd];
+                if (!receive_partial(fd, partial))
+                {
+                    close(fd);
+                    idle.erase(fd);
+                }
+                else if (partial.filled == sizeof(partial.bytes))
+                {
+                    PendingRequest pending;
+                    pending.fd = fd;
+                    memcpy(&pending.request, partial.bytes, sizeof(pending.request));
+                    queue.requests.push_back(pending);
+                    idle.erase(fd);
+                }
+            }
+            queue.ready.notify_all();
+        }
+
+        if (polled[1].revents & POLLIN)
+        {
+            char drain[64];
+            while (read(queue.wake_fds[0], drain, sizeof(drain)) > 0) {}
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (int fd : queue.returned)
+            {
+                idle[fd] = PartialRequest{{0}, 0};
+            }
+            queue.returned.clear();
+        }
+
+        if (polled[0].revents & POLLIN)
+        {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0)
+            {
+                // A client that stops reading its response only holds a worker this long
+                struct timeval timeout = {RTP_DAEMON_SEND_TIMEOUT_S, 0};
+                setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                idle[fd] = PartialRequest{{0}, 0};
+            }
+            else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                // Out of descriptors or an aborted handshake: existing clients are still served,
+                // and the pending connection is retried once descriptors free up
+                perror("accept");
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) usleep(100000);
+            }
+        }
+    }
+
+    // Only reached when poll fails for good; workers block forever, so leave with the process
+    close(listen_fd);
+    unlink(socket_path);
+    for (std::thread &worker : workers)
+    {
+        worker.detach();
+    }
+    return 1;
+}
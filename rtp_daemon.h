@@ -0,0 +1,41 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+// Binary protocol of the count_primes.out --daemon query server (Unix domain socket).
+// All fields are native-endian. A client may send any number of requests on one connection;
+// every request gets exactly one response, in order.
+#ifndef RTP_DAEMON_H
+#define RTP_DAEMON_H
+
+#include <stdint.h>
+
+enum RtpDaemonOp
+{
+    RTP_OP_COUNT = 1,     // arg = digits, value = RtpEngine -> [has_prime_counts, depth, rt[1..d], primes[1..d]]
+                          // (primes[k] is only valid for k <= depth; higher levels were never sieved)
+    RTP_OP_ENUMERATE = 2, // arg = max digits                -> every right-truncatable prime, ascending
+    RTP_OP_QUERY = 3      // value = n                       -> [is_prime, is_right_truncatable, prefix_depth]
+};
+
+// Fixed 16-byte request
+struct RtpDaemonRequest
+{
+    uint32_t op;
+    uint32_t arg;
+    uint64_t value;
+};
+
+// Response header, followed by count 64-bit payload words
+struct RtpDaemonResponse
+{
+    uint32_t status; // RtpStatus, or RTP_DAEMON_BAD_REQUEST for an unknown op/engine
+    uint32_t count;
+};
+
+static const uint32_t RTP_DAEMON_BAD_REQUEST = 0xFFFFFFFFu;
+
+// Serve requests on socket_path until the process is killed: connections are polled and read by
+// the calling thread and each complete request is answered by one of a pool of threads
+int run_daemon(const char *socket_path, int threads);
+
+#endif // RTP_DAEMON_H
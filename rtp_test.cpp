@@ -0,0 +1,255 @@
+// Author   : Ebod Shojaei
+// Updated  : 30-11-2025
+
+// Known-answer tests for the librtp primality kernels and truncation trees (exit status 1 on failure)
+#include <stdio.h>
+#include "rtp.h"
+
+static int g_failures = 0;
+
+// Report a failed check with its source line
+#define CHECK(cond)                                                   \
+    do                                                                \
+    {                                                                 \
+        if (!(cond))                                                  \
+        {                                                             \
+            fprintf(stderr, "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            g_failures++;                                             \
+        }                                                             \
+    } while (0)
+
+// Utility function to parse a decimal string into a 128-bit integer
+static rtp_u128 u128(const char *digits)
+{
+    rtp_u128 value = 0;
+    for (const char *p = digits; *p; ++p)
+    {
+        value = value * 10 + (rtp_u128)(*p - '0');
+    }
+    return value;
+}
+
+// Utility function to parse a decimal string into 8 limbs, returns the number of limbs in use
+static int limbs_from_decimal(const char *digits, uint64_t limbs[8])
+{
+    for (int i = 0; i < 8; ++i) limbs[i] = 0;
+    for (const char *p = digits; *p; ++p)
+    {
+        rtp_u128 carry = (rtp_u128)(*p - '0');
+        for (int i = 0; i < 8; ++i)
+        {
+            rtp_u128 t = (rtp_u128)limbs[i] * 10 + carry;
+            limbs[i] = (uint64_t)t;
+            carry = t >> 64;
+        }
+    }
+    int count = 8;
+    while (count > 1 && limbs[count - 1] == 0) count--;
+    return count;
+}
+
+// Helper function to test 2^bits - c (bits a multiple of 64, or 255) with is_probable_prime_limbs
+static bool is_prime_power_of_two_minus(int bits, uint64_t c)
+{
+    uint64_t limbs[8];
+    int count = (bits + 63) / 64;
+    for (int i = 0; i < count; ++i) limbs[i] = ~(uint64_t)0;
+    if (bits % 64 != 0) limbs[count - 1] >>= 64 - bits % 64;
+    limbs[0] -= c - 1; // 2^bits - 1 - (c - 1), the low limb is all ones so nothing borrows
+    return is_probable_prime_limbs(limbs, count);
+}
+
+// Helper function to total a tree count over every digit length it supports
+static uint64_t tree_total(RtpPolicy policy, int base)
+{
+    int digits = rtp_max_digits(policy, base);
+    std::vector<uint64_t> per_digit(digits + 1, 0);
+    if (count_truncatable_primes_tree(policy, per_digit, digits, 1, base) < 0) return 0;
+
+    uint64_t total = 0;
+    for (int i = 1; i <= digits; ++i)
+    {
+        total += per_digit[i];
+    }
+    return total;
+}
+
+// Baillie-PSW past 2^64: Mersenne and near-2^128 primes, and strong base-2 pseudoprimes
+static void test_is_prime_u128()
+{
+    const rtp_u128 one = 1;
+    CHECK(is_prime_u128((one << 127) - 1));
+    CHECK(is_prime_u128(~(rtp_u128)0 - 158)); // 2^128 - 159
+    CHECK(!is_prime_u128(~(rtp_u128)0 - 156)); // 2^128 - 157
+    CHECK(is_prime_u128(u128("18446744073709551629"))); // Smallest prime above 2^64
+    CHECK(!is_prime_u128((one << 64) + 1));
+
+    // Strong pseudoprimes to base 2 above 2^64 (p(2p - 1) and Chernick forms), so only the
+    // Lucas half of the test can reject them
+    static const char *pseudoprimes[] = {
+        "36893525818586872753", "36893537157307194253", "36893582512205904253",
+        "36893622507003352261", "36893697136528721581", "1506334550815795554361",
+        "1508785762539178381681", "1510447215140608684969"};
+    for (const char *n : pseudoprimes)
+    {
+        CHECK(!is_prime_u128(u128(n)));
+    }
+}
+
+// Left-truncatable trees run entirely on 128-bit words
+static void test_left_trees()
+{
+    CHECK(tree_total(RTP_POLICY_LEFT, 10) == 4260);
+    CHECK(tree_total(RTP_POLICY_LEFT, 12) == 170053);
+}
+
+// Miller-Rabin in MontgomeryBig at 3, 4, 6 and 8 limbs
+static void test_is_probable_prime_limbs()
+{
+    CHECK(is_prime_power_of_two_minus(192, 237));
+    CHECK(is_prime_power_of_two_minus(255, 19));
+    CHECK(is_prime_power_of_two_minus(384, 317));
+    CHECK(is_prime_power_of_two_minus(512, 569));
+    CHECK(!is_prime_power_of_two_minus(512, 567));
+    CHECK(!is_prime_power_of_two_minus(256, 187));
+
+    uint64_t limbs[8];
+    // M127 * (2^128 - 159): two large factors, no small one
+    int count = limbs_from_decimal("57896044618658097711785492504343953899242261795684735710927136105699223797919", limbs);
+    CHECK(!is_probable_prime_limbs(limbs, count));
+    // p(2p - 1) with a 101-bit p: a strong pseudoprime to base 2 that the base 3 round rejects
+    count = limbs_from_decimal("3213876088517980551083924217705890991590010125956200958684753", limbs);
+    CHECK(!is_probable_prime_limbs(limbs, count));
+    // 128-bit values still go through BPSW
+    count = limbs_from_decimal("170141183460469231731687303715884105727", limbs);
+    CHECK(is_probable_prime_limbs(limbs, count));
+}
+
+// Right-truncatable trees that outgrow 128 bits and continue on BigUInt (Miller-Rabin in
+// MontgomeryBig), compared with independent totals
+static void test_wide_right_trees()
+{
+    CHECK(tree_total(RTP_POLICY_RIGHT, 10) == 83);
+    CHECK(tree_total(RTP_POLICY_RIGHT, 34) == 38956);
+    CHECK(tree_total(RTP_POLICY_RIGHT, 35) == 39323);
+    CHECK(tree_total(RTP_POLICY_RIGHT, 36) == 58857);
+}
+
+// Lucy-Hedgehog pi(x) against known values, serial and threaded
+static void test_prime_pi()
+{
+    static const uint64_t pi_powers_of_10[] = {0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455,
+                                               50847534, 455052511, 4118054813ULL, 37607912018ULL};
+    for (int k = 0; k <= 12; ++k)
+    {
+        CHECK(rtp_prime_pi(power_of_10(k), 1) == pi_powers_of_10[k]);
+    }
+    CHECK(rtp_prime_pi(0, 1) == 0);
+    CHECK(rtp_prime_pi(2, 1) == 1);
+    CHECK(rtp_prime_pi(4294967311ULL, 1) == 203280222); // 2^32 + 15 is prime
+
+    // Threads only split each sieving step, so every count must match the serial run
+    static const uint64_t xs[] = {1000, 999983, 4294967311ULL, 100000000000ULL};
+    for (uint64_t x : xs)
+    {
+        uint64_t serial = rtp_prime_pi(x, 1);
+        CHECK(rtp_prime_pi(x, 2) == serial);
+        CHECK(rtp_prime_pi(x, 4) == serial);
+    }
+
+    // One run at 10^10 - 1 gives every digit band
+    std::vector<uint64_t> primes_per_digit;
+    CHECK(rtp_count_primes_per_digit(primes_per_digit, 1, 10, 10, 2) == RTP_OK);
+    for (int k = 1; k <= 10; ++k)
+    {
+        CHECK(primes_per_digit[k] == pi_powers_of_10[k] - pi_powers_of_10[k - 1]);
+    }
+}
+
+// RtpRange yields every tree node once, ascending, in any policy and base
+static void test_range()
+{
+    CHECK(RtpRange(-1).begin() == RtpRange(-1).end());
+    CHECK(RtpRange(0).begin() == RtpRange(0).end());
+    CHECK(RtpRange(8, RTP_POLICY_RIGHT, 1).begin() == RtpRange(8, RTP_POLICY_RIGHT, 1).end());
+
+    struct
+    {
+        RtpPolicy policy;
+        int base;
+        uint64_t total;
+    } trees[] = {{RTP_POLICY_RIGHT, 10, 83}, {RTP_POLICY_LEFT, 10, 4260}, {RTP_POLICY_TWO_SIDED, 10, 15},
+                 {RTP_POLICY_RIGHT, 12, 179}, {RTP_POLICY_LEFT, 12, 170053}};
+    for (const auto &tree : trees)
+    {
+        uint64_t count = 0;
+        rtp_u128 previous = 0;
+        bool ascending = true;
+        for (const RtpPrime &prime : RtpRange(rtp_max_digits(tree.policy, tree.base), tree.policy, tree.base))
+        {
+            ascending = ascending && prime.value > previous;
+            previous = prime.value;
+            count++;
+        }
+        CHECK(count == tree.total);
+        CHECK(ascending);
+    }
+
+    // The base-10 range matches the compile-time table value for value
+    int i = 0;
+    for (const RtpPrime &prime : RtpRange(8))
+    {
+        CHECK(i < kRtpBase10Table.count && prime.value == kRtpBase10Table.values[i]);
+        i++;
+    }
+    CHECK(i == 83);
+}
+
+// Sieve engines stop after the first empty level (9 digits in base 10) and report zeros above it,
+// matching the sieve-free engines; threaded sieve runs must match serial ones
+static void test_engine_early_stop()
+{
+    static const uint64_t right_trunc_per_digit[] = {0, 4, 9, 14, 16, 15, 12, 8, 5, 0, 0, 0, 0};
+    static const uint64_t primes_per_digit[] = {0, 4, 21, 143, 1061, 8363, 68906, 586081, 5096876, 45086079};
+
+    // Sieve and memo share the serial context's prime buffers; the threaded context sieves its own
+    RtpContext serial(1), threaded(4);
+    struct
+    {
+        RtpContext *context;
+        RtpEngine engine;
+    } runs[] = {{&serial, RTP_ENGINE_SIEVE}, {&serial, RTP_ENGINE_MEMO}, {&serial, RTP_ENGINE_STREAM},
+                {&threaded, RTP_ENGINE_SIEVE}, {&serial, RTP_ENGINE_TREE}, {&serial, RTP_ENGINE_TABLE}};
+    for (const auto &run : runs)
+    {
+        RtpResult result = run.context->count(12, run.engine);
+        CHECK(result.status == RTP_OK);
+        CHECK(result.depth == (result.has_prime_counts ? 9 : 12));
+        if (result.right_trunc_per_digit.size() != 13) continue;
+        for (int k = 1; k <= 12; ++k)
+        {
+            CHECK(result.right_trunc_per_digit[k] == right_trunc_per_digit[k]);
+            if (result.has_prime_counts) CHECK(result.primes_per_digit[k] == (k <= 9 ? primes_per_digit[k] : 0));
+        }
+    }
+}
+
+// Driver function to run every test
+int main()
+{
+    test_is_prime_u128();
+    test_left_trees();
+    test_is_probable_prime_limbs();
+    test_wide_right_trees();
+    test_range();
+    test_prime_pi();
+    test_engine_early_stop();
+
+    if (g_failures > 0)
+    {
+        printf("%d check(s) failed.\n", g_failures);
+        return 1;
+    }
+    printf("All checks passed.\n");
+    return 0;
+}
@@ -11,5 +11,14 @@ g++ test.cpp -o test.out -L./primesieve -lprimesieve -Wl,-rpath,@loader_path/pri
 # Run the test program
 ./test.out
 rm test.out
+# Build the librtp static library
+g++ -O2 -c rtp.cpp -o rtp.o -pthread
+ar rcs librtp.a rtp.o
+rm rtp.o
 # Compile the main program
-g++ count_primes.cpp -o count_primes.out -L./primesieve -lprimesieve -Wl,-rpath,@loader_path/primesieve
+g++ count_primes.cpp rtp_daemon.cpp -o count_primes.out -pthread -L. -lrtp -L./primesieve -lprimesieve -Wl,-rpath,@loader_path/primesieve
+# Compile and run the librtp known-answer tests (exit status 1 on any failed check)
+g++ -O2 rtp_test.cpp -o rtp_test.out -pthread -L. -lrtp -L./primesieve -lprimesieve -Wl,-rpath,@loader_path/primesieve
+./rtp_test.out
+# Compile the benchmark suite (optional): ./bench.out [--max-digits=N] [--baseline=FILE] [--save-baseline=FILE]
+g++ -O2 bench.cpp -o bench.out -pthread -L. -lrtp -L./primesieve -lprimesieve -Wl,-rpath,@loader_path/primesieve